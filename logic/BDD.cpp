@@ -0,0 +1,252 @@
+#include <unordered_map>
+
+#include "BDD.h"
+#include "ImplicantHashSet.h"
+
+namespace logic
+{
+	BDDManager::BDDManager(size_t cacheSize) : nodes{{TERMINAL_VARIABLE, ZERO, ZERO}, {TERMINAL_VARIABLE, ONE, ONE}},
+											   unique(1U << 10, ZERO)
+	{
+		size_t size = 1;
+		while (size < cacheSize)
+			size *= 2;
+		// An entry whose result is ZERO and whose operands are both ZERO is never looked up
+		cache.assign(size, {Operation::AND, ZERO, ZERO, ZERO});
+	}
+
+	size_t BDDManager::Hash(uint32_t x, uint32_t y, uint32_t z)
+	{
+		return ImplicantHashSet::Hash((ullong(x) << 32) | y, z);
+	}
+
+	BDDManager::Node BDDManager::FindOrAdd(uint32_t variable, Node low, Node high)
+	{
+		size_t slotMask = unique.size() - 1;
+		for (size_t slot = Hash(variable, low, high) & slotMask;; slot = (slot + 1) & slotMask)
+		{
+			Node node = unique[slot];
+			if (node == ZERO)
+			{
+				node = static_cast<Node>(nodes.size());
+				nodes.push_back({variable, low, high});
+				unique[slot] = node;
+				break;
+			}
+			if (nodes[node].variable == variable && nodes[node].low == low && nodes[node].high == high)
+				return node;
+		}
+		// The table is rebuilt at twice the size once it is half full
+		if (2 * nodes.size() > unique.size())
+		{
+			std::vector<Node> old(2 * unique.size(), ZERO);
+			std::swap(old, unique);
+			slotMask = unique.size() - 1;
+			for (auto node : old)
+				if (node != ZERO)
+				{
+					size_t slot = Hash(nodes[node].variable, nodes[node].low, nodes[node].high) & slotMask;
+					while (unique[slot] != ZERO)
+						slot = (slot + 1) & slotMask;
+					unique[slot] = node;
+				}
+		}
+		return static_cast<Node>(nodes.size() - 1);
+	}
+
+	bool BDDManager::FindCached(Operation operation, Node x, Node y, Node &result) const
+	{
+		auto &entry = cache[Hash(static_cast<uint32_t>(operation), x, y) & (cache.size() - 1)];
+		if (entry.operation != operation || entry.x != x || entry.y != y)
+			return false;
+		result = entry.result;
+		return true;
+	}
+
+	void BDDManager::Cache(Operation operation, Node x, Node y, Node result)
+	{
+		cache[Hash(static_cast<uint32_t>(operation), x, y) & (cache.size() - 1)] = {operation, x, y, result};
+	}
+
+	BDDManager::Node BDDManager::MakeNode(uint32_t variable, Node low, Node high)
+	{
+		return low == high ? low : FindOrAdd(variable, low, high);
+	}
+
+	BDDManager::Node BDDManager::MakeZDDNode(uint32_t variable, Node low, Node high)
+	{
+		return high == ZERO ? low : FindOrAdd(variable, low, high);
+	}
+
+	BDDManager::Node BDDManager::FromCareSet(const TruthTable &table)
+	{
+		return FromCareSet(table, 0, 0);
+	}
+
+	BDDManager::Node BDDManager::FromCareSet(const TruthTable &table, uint32_t variable, ullong first)
+	{
+		// The range holds the minterms whose letters before the variable are fixed
+		ullong size = table.GetSize() >> variable;
+		bool isZero = true, isOne = true;
+		if (size >= TruthTable::WORD_SIZE)
+			for (ullong i = first >> TruthTable::WORD_BITS; i < (first + size) >> TruthTable::WORD_BITS; ++i)
+			{
+				isZero &= table.CareWord(i) == 0;
+				isOne &= table.CareWord(i) == ~0ULL;
+			}
+		else
+		{
+			ullong range = (1ULL << size) - 1,
+					bits = table.CareWord(first >> TruthTable::WORD_BITS) >> (first % TruthTable::WORD_SIZE) & range;
+			isZero = bits == 0;
+			isOne = bits == range;
+		}
+		if (isZero || isOne)
+			return isOne ? ONE : ZERO;
+		// Letter A is the highest bit of a minterm, so the lower half of the range is its negative cofactor
+		Node low = FromCareSet(table, variable + 1, first);
+		return MakeNode(variable, low, FromCareSet(table, variable + 1, first + size / 2));
+	}
+
+	BDDManager::Node BDDManager::And(Node f, Node g)
+	{
+		if (f == ZERO || g == ZERO)
+			return ZERO;
+		if (f == ONE || f == g)
+			return g;
+		if (g == ONE)
+			return f;
+		if (f > g)
+			std::swap(f, g);
+		Node result;
+		if (FindCached(Operation::AND, f, g, result))
+			return result;
+		uint32_t variable = std::min(nodes[f].variable, nodes[g].variable);
+		Node f0 = nodes[f].variable == variable ? nodes[f].low : f, f1 = nodes[f].variable == variable ? nodes[f].high : f,
+				g0 = nodes[g].variable == variable ? nodes[g].low : g, g1 = nodes[g].variable == variable ? nodes[g].high : g;
+		Node low = And(f0, g0);
+		result = MakeNode(variable, low, And(f1, g1));
+		Cache(Operation::AND, f, g, result);
+		return result;
+	}
+
+	BDDManager::Node BDDManager::Union(Node p, Node q)
+	{
+		if (p == ZERO || p == q)
+			return q;
+		if (q == ZERO)
+			return p;
+		if (p > q)
+			std::swap(p, q);
+		Node result;
+		if (FindCached(Operation::UNION, p, q, result))
+			return result;
+		uint32_t variable = std::min(nodes[p].variable, nodes[q].variable);
+		// A family whose top variable is below the variable has no sets that contain it
+		if (nodes[p].variable != variable)
+			result = MakeZDDNode(variable, Union(p, nodes[q].low), nodes[q].high);
+		else if (nodes[q].variable != variable)
+			result = MakeZDDNode(variable, Union(nodes[p].low, q), nodes[p].high);
+		else
+		{
+			Node low = Union(nodes[p].low, nodes[q].low);
+			result = MakeZDDNode(variable, low, Union(nodes[p].high, nodes[q].high));
+		}
+		Cache(Operation::UNION, p, q, result);
+		return result;
+	}
+
+	BDDManager::Node BDDManager::Difference(Node p, Node q)
+	{
+		if (p == ZERO || p == q)
+			return ZERO;
+		if (q == ZERO)
+			return p;
+		Node result;
+		if (FindCached(Operation::DIFFERENCE, p, q, result))
+			return result;
+		uint32_t variable = std::min(nodes[p].variable, nodes[q].variable);
+		if (nodes[p].variable != variable)
+			result = Difference(p, nodes[q].low);
+		else if (nodes[q].variable != variable)
+			result = MakeZDDNode(variable, Difference(nodes[p].low, q), nodes[p].high);
+		else
+		{
+			Node low = Difference(nodes[p].low, nodes[q].low);
+			result = MakeZDDNode(variable, low, Difference(nodes[p].high, nodes[q].high));
+		}
+		Cache(Operation::DIFFERENCE, p, q, result);
+		return result;
+	}
+
+	BDDManager::Node BDDManager::Change(Node p, uint32_t variable)
+	{
+		if (p == ZERO)
+			return ZERO;
+		// None of the sets contains a variable above the top variable of the family
+		if (nodes[p].variable > variable)
+			return MakeZDDNode(variable, ZERO, p);
+		if (nodes[p].variable == variable)
+			return MakeZDDNode(variable, nodes[p].high, nodes[p].low);
+		Node result;
+		if (FindCached(Operation::CHANGE, p, variable, result))
+			return result;
+		Node low = Change(nodes[p].low, variable);
+		result = MakeZDDNode(nodes[p].variable, low, Change(nodes[p].high, variable));
+		Cache(Operation::CHANGE, p, variable, result);
+		return result;
+	}
+
+	ullong BDDManager::Count(Node zdd) const
+	{
+		std::unordered_map<Node, ullong> counts{{ZERO, 0}, {ONE, 1}};
+		auto count = [this, &counts](Node node, auto &count) -> ullong {
+			auto it = counts.find(node);
+			if (it != counts.end())
+				return it->second;
+			ullong result = count(nodes[node].low, count) + count(nodes[node].high, count);
+			return counts[node] = result;
+		};
+		return count(zdd, count);
+	}
+
+	BDDManager::Node BDDManager::GetPrimeImplicants(Node f)
+	{
+		// The only prime implicant of 1 is the empty product, and 0 has none
+		if (f == ZERO || f == ONE)
+			return f;
+		Node result;
+		if (FindCached(Operation::PRIME_IMPLICANTS, f, ZERO, result))
+			return result;
+		uint32_t variable = nodes[f].variable;
+		Node f0 = nodes[f].low, f1 = nodes[f].high;
+		Node common = GetPrimeImplicants(And(f0, f1));
+		Node negative = Difference(GetPrimeImplicants(f0), common);
+		Node positive = Difference(GetPrimeImplicants(f1), common);
+		// The positive literal is above the negative one, and both are above the literals of the cofactors
+		result = MakeZDDNode(2 * variable, MakeZDDNode(2 * variable + 1, common, negative), positive);
+		Cache(Operation::PRIME_IMPLICANTS, f, ZERO, result);
+		return result;
+	}
+
+	void BDDManager::ToImplicants(Node zdd, unsigned char nVariables, ImplicantTable &implicants) const
+	{
+		ToImplicants(zdd, nVariables, 0, 0, implicants);
+	}
+
+	void BDDManager::ToImplicants(Node zdd, unsigned char nVariables, ullong form, ullong mask,
+								  ImplicantTable &implicants) const
+	{
+		if (zdd == ZERO)
+			return;
+		if (zdd == ONE)
+		{
+			implicants.PushBack(form, mask);
+			return;
+		}
+		uint32_t variable = nodes[zdd].variable;
+		ullong sampler = 1ULL << (nVariables - 1 - variable / 2);
+		ToImplicants(nodes[zdd].low, nVariables, form, mask, implicants);
+		ToImplicants(nodes[zdd].high, nVariables, variable % 2 == 0 ? form | sampler : form, mask | sampler, implicants);
+	}
+}
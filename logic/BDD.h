@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ImplicantTable.h"
+#include "TruthTable.h"
+
+namespace logic
+{
+	/**
+	 * Store of reduced ordered binary decision diagrams (BDDs) and zero-suppressed decision diagrams (ZDDs).
+	 * Both kinds of diagrams are made of the same nodes, which are kept unique by a hash table, so equal
+	 * diagrams are the same node. Results of operations are memoized in a computed cache of fixed size,
+	 * which forgets an entry when another one hashes to the same slot.
+	 *
+	 * Variable 0 is at the top of every diagram. In a BDD, a node whose children are equal is removed,
+	 * in a ZDD, a node whose high child is <code>ZERO</code> is removed. Terminal <code>ZERO</code>
+	 * is the empty family of sets and terminal <code>ONE</code> is the family that only contains the empty set
+	 * when they are read as ZDDs.
+	 */
+	class BDDManager
+	{
+	public:
+		using Node = uint32_t;
+
+		static constexpr Node ZERO = 0, ONE = 1;
+
+	private:
+		struct NodeData
+		{
+			uint32_t variable;
+			Node low, high;
+		};
+
+		enum class Operation : uint32_t
+		{
+			AND, UNION, DIFFERENCE, CHANGE, PRIME_IMPLICANTS
+		};
+
+		struct CacheEntry
+		{
+			Operation operation;
+			Node x, y, result;
+		};
+
+		// Variable of the terminals, which is below all other variables
+		static constexpr uint32_t TERMINAL_VARIABLE = UINT32_MAX;
+
+		std::vector<NodeData> nodes;
+		// Open addressing hash table of node indices, kept at most half full. 0 marks an empty slot,
+		// since the terminals are never in the table.
+		std::vector<Node> unique;
+		std::vector<CacheEntry> cache;
+
+		static size_t Hash(uint32_t x, uint32_t y, uint32_t z);
+
+		/** @return Node with the given variable and children, which must be reduced already. */
+		Node FindOrAdd(uint32_t variable, Node low, Node high);
+
+		bool FindCached(Operation operation, Node x, Node y, Node &result) const;
+
+		void Cache(Operation operation, Node x, Node y, Node result);
+
+		/** Builds the BDD of the care set of <code>table</code> over the minterms of the given range. */
+		Node FromCareSet(const TruthTable &table, uint32_t variable, ullong first);
+
+		void ToImplicants(Node zdd, unsigned char nVariables, ullong form, ullong mask, ImplicantTable &implicants) const;
+
+	public:
+		/**
+		 * @param cacheSize - Number of entries of the computed cache. It is rounded up to a power of 2.
+		 */
+		explicit BDDManager(size_t cacheSize = 1U << 18);
+
+		// Nodes
+
+		/** @return BDD node with the given variable and children, or <code>low</code> if both children are equal. */
+		Node MakeNode(uint32_t variable, Node low, Node high);
+
+		/**
+		 * @return ZDD node with the given variable and children, or <code>low</code> if <code>high</code>
+		 * is <code>ZERO</code>.
+		 */
+		Node MakeZDDNode(uint32_t variable, Node low, Node high);
+
+		uint32_t GetVariable(Node node) const
+		{ return nodes[node].variable; }
+
+		Node GetLow(Node node) const
+		{ return nodes[node].low; }
+
+		Node GetHigh(Node node) const
+		{ return nodes[node].high; }
+
+		/** @return The number of nodes in the store, including the terminals and nodes no longer in use. */
+		size_t GetNodeCount() const
+		{ return nodes.size(); }
+
+		// BDD operations
+
+		/**
+		 * @return BDD of the minterms of <code>table</code> that are ON or don't care. Variable <code>i</code>
+		 * of the BDD is the letter at index <code>i</code> (variable A is 0).
+		 */
+		Node FromCareSet(const TruthTable &table);
+
+		Node And(Node f, Node g);
+
+		// ZDD operations
+
+		Node Union(Node p, Node q);
+
+		/** @return Family of the sets of <code>p</code> that are not in <code>q</code>. */
+		Node Difference(Node p, Node q);
+
+		/**
+		 * @return Family of the sets of <code>p</code> with the membership of <code>variable</code> flipped,
+		 * i.e. <code>variable</code> added to each set that doesn't contain it and removed from each set that does.
+		 */
+		Node Change(Node p, uint32_t variable);
+
+		/** @return The number of sets in the family, modulo 2^64. */
+		ullong Count(Node zdd) const;
+
+		/**
+		 * Finds the prime implicants of the function given by a BDD, without enumerating them, by the recursion
+		 * P(f) = P(f0 f1) + x'(P(f0) - P(f0 f1)) + x(P(f1) - P(f0 f1)), where x is the top variable of f
+		 * and f0 and f1 are its cofactors.
+		 * @return ZDD of the prime implicants as sets of literals, where variable <code>2i</code> of the ZDD
+		 * is the positive and <code>2i + 1</code> the negative literal of variable <code>i</code> of the BDD.
+		 */
+		Node GetPrimeImplicants(Node f);
+
+		/**
+		 * Appends the implicants given by a ZDD of literals (see <code>GetPrimeImplicants()</code>) to
+		 * <code>implicants</code>. Variable <code>i</code> of the BDD is the letter at index <code>i</code>.
+		 */
+		void ToImplicants(Node zdd, unsigned char nVariables, ImplicantTable &implicants) const;
+	};
+}
@@ -0,0 +1,506 @@
+#include <limits>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "CoverSolver.h"
+#include "../numeric/NumericGeneral.h"
+
+namespace logic
+{
+	/**
+	 * Pool of tasks with one queue per thread. A thread takes the most recent task from its own queue
+	 * and steals the oldest task (the largest subtree) from the queues of other threads.
+	 */
+	class CoverSolver::TaskPool
+	{
+		std::vector<std::deque<Task>> queues;
+		std::vector<std::mutex> mutexes;
+		// Tasks that have been pushed but not finished, and threads that are waiting for a task
+		std::atomic<size_t> nPending{0};
+		std::atomic<unsigned> nIdle{0};
+		// Idle threads sleep until a task is pushed or all tasks are finished
+		std::mutex idleMutex;
+		std::condition_variable idleCondition;
+
+		bool TryPop(unsigned thread, Task &task)
+		{
+			for (unsigned i = 0; i < queues.size(); ++i)
+			{
+				unsigned victim = (thread + i) % queues.size();
+				std::lock_guard<std::mutex> lock(mutexes[victim]);
+				if (queues[victim].empty())
+					continue;
+				if (victim == thread)
+				{
+					task = std::move(queues[victim].back());
+					queues[victim].pop_back();
+				}
+				else
+				{
+					task = std::move(queues[victim].front());
+					queues[victim].pop_front();
+				}
+				return true;
+			}
+			return false;
+		}
+
+	public:
+		explicit TaskPool(unsigned nThreads) : queues(nThreads), mutexes(nThreads)
+		{}
+
+		void Push(unsigned thread, Task task)
+		{
+			++nPending;
+			{
+				std::lock_guard<std::mutex> lock(mutexes[thread]);
+				queues[thread].push_back(std::move(task));
+			}
+			// A thread that becomes idle after this check finds the task before it goes to sleep
+			if (nIdle != 0)
+			{
+				std::lock_guard<std::mutex> lock(idleMutex);
+				idleCondition.notify_one();
+			}
+		}
+
+		/**
+		 * Waits for a task.
+		 * @return <code>false</code> if all tasks have been finished, so none will ever come.
+		 */
+		bool Pop(unsigned thread, Task &task)
+		{
+			if (TryPop(thread, task))
+				return true;
+			std::unique_lock<std::mutex> lock(idleMutex);
+			++nIdle;
+			bool found;
+			while (!(found = TryPop(thread, task)) && nPending != 0)
+				idleCondition.wait(lock);
+			--nIdle;
+			return found;
+		}
+
+		/** Must be called once a popped task has been explored. */
+		void Finish()
+		{
+			if (--nPending == 0)
+			{ // No task will ever come, so all idle threads can return
+				std::lock_guard<std::mutex> lock(idleMutex);
+				idleCondition.notify_all();
+			}
+		}
+
+		/**
+		 * @return Whether a thread should hand out its branches, which is the case if some thread
+		 * is waiting for a task and the queue of this thread has nothing left to steal.
+		 */
+		bool IsStarving(unsigned thread)
+		{
+			if (nIdle == 0)
+				return false;
+			std::lock_guard<std::mutex> lock(mutexes[thread]);
+			return queues[thread].empty();
+		}
+	};
+
+	CoverSolver::CoverSolver(const ImplicantTable &primeImplicants, const std::vector<ullong> &minterms)
+			: CoverSolver(CoverTable(primeImplicants, minterms))
+	{}
+
+	CoverSolver::CoverSolver(const CoverTable &table)
+	{
+		std::vector<size_t> columnIndex(table.GetColumnCount());
+		for (size_t j = 0; j < table.GetColumnCount(); ++j)
+			if (table.IsColumnActive(j))
+			{
+				columnIndex[j] = columnRows.size();
+				columnRows.emplace_back();
+			}
+		for (size_t i = 0; i < table.GetRowCount(); ++i)
+			if (table.IsRowActive(i) && !table.GetRowColumns(i).empty())
+			{
+				size_t row = rowIds.size();
+				rowIds.push_back(i);
+				rowCost.push_back(table.GetRowCost(i));
+				rowColumns.emplace_back();
+				for (auto j : table.GetRowColumns(i))
+				{
+					rowColumns[row].push_back(columnIndex[j]);
+					columnRows[columnIndex[j]].push_back(row);
+				}
+			}
+		matrix = CoverageMatrix(rowIds.size(), columnRows.size());
+		for (size_t i = 0; i < rowColumns.size(); ++i)
+			for (auto j : rowColumns[i])
+				matrix.Set(i, j);
+		// Cheaper rows are tried first, so that a good incumbent is found early
+		for (auto &rows : columnRows)
+			std::stable_sort(rows.begin(), rows.end(), [this](size_t x, size_t y) {
+				return rowCost[x] < rowCost[y];
+			});
+	}
+
+	CoverSolver::SearchState CoverSolver::CreateState() const
+	{
+		SearchState state;
+		// Every chosen row covers at least one new column, so the depth of the search never exceeds the number of columns
+		state.covered.assign((columnRows.size() + 1) * matrix.GetWordCount(), 0);
+		state.excluded.assign(rowCost.size(), false);
+		state.rowStamp.assign(rowCost.size(), 0);
+		return state;
+	}
+
+	std::vector<CoverSolver::SearchState> CoverSolver::RunSearch(unsigned nThreads, bool findAll, int upperBound)
+	{
+		bestCost = upperBound;
+		CoverSolver::findAll = findAll;
+		stopped = false;
+		nNodes = 0;
+		// Small tables are solved before a pool would even have started
+		constexpr size_t MIN_PARALLEL_COLUMNS = 32;
+		if (columnRows.size() < MIN_PARALLEL_COLUMNS)
+			nThreads = 1;
+		std::vector<SearchState> states(std::max(nThreads, 1U));
+		for (unsigned i = 0; i < states.size(); ++i)
+		{
+			states[i] = CreateState();
+			states[i].thread = i;
+		}
+		if (states.size() == 1)
+			Run(states[0], Task{{}, {}, 0}, nullptr);
+		else
+		{
+			TaskPool pool(states.size());
+			pool.Push(0, Task{{}, {}, 0});
+			auto worker = [this, &pool](SearchState &state) {
+				for (Task task; pool.Pop(state.thread, task); pool.Finish())
+					Run(state, task, &pool);
+			};
+			std::vector<std::thread> threads;
+			for (unsigned i = 1; i < states.size(); ++i)
+				threads.emplace_back(worker, std::ref(states[i]));
+			worker(states[0]);
+			for (auto &thread : threads)
+				thread.join();
+		}
+		return states;
+	}
+
+	std::vector<std::vector<size_t>> CoverSolver::Solve(unsigned nThreads)
+	{
+		auto states = RunSearch(nThreads, true, std::numeric_limits<int>::max());
+		// Threads may have kept covers that turned out to be more expensive than those of other threads
+		std::vector<std::vector<size_t>> solutions;
+		for (auto &state : states)
+			if (!state.solutions.empty() && state.solutionCost == bestCost)
+				for (auto &solution : state.solutions)
+				{
+					solutions.push_back(solution);
+					for (auto &row : solutions.back())
+						row = rowIds[row];
+					std::sort(solutions.back().begin(), solutions.back().end());
+				}
+		std::sort(solutions.begin(), solutions.end());
+		return solutions;
+	}
+
+	void CoverSolver::Run(SearchState &state, const Task &task, TaskPool *pool)
+	{
+		size_t nWords = matrix.GetWordCount();
+		std::fill(state.excluded.begin(), state.excluded.end(), false);
+		for (auto row : task.excluded)
+			state.excluded[row] = true;
+		state.chosen = task.chosen;
+		std::fill(state.covered.begin(), state.covered.begin() + nWords, 0);
+		for (auto row : task.chosen)
+			CoverageMatrix::Or(state.covered.data(), state.covered.data(), matrix.Row(row), nWords);
+		Search(state, task.cost, 0, pool);
+	}
+
+	int CoverSolver::FindMinimumCost(unsigned nThreads)
+	{
+		RunSearch(nThreads, false, std::numeric_limits<int>::max());
+		return bestCost;
+	}
+
+	bool CoverSolver::FindMinimumCover(std::vector<size_t> &cover, int upperBound,
+									   std::chrono::steady_clock::time_point deadline, ullong nodeBudget,
+									   unsigned nThreads)
+	{
+		CoverSolver::deadline = deadline;
+		CoverSolver::nodeBudget = nodeBudget;
+		auto states = RunSearch(nThreads, false, upperBound);
+		CoverSolver::deadline = std::chrono::steady_clock::time_point::max();
+		CoverSolver::nodeBudget = 0;
+		for (auto &state : states)
+			if (!state.solutions.empty() && state.solutionCost == bestCost)
+			{
+				cover = state.solutions[0];
+				for (auto &row : cover)
+					row = rowIds[row];
+				std::sort(cover.begin(), cover.end());
+				break;
+			}
+		return !stopped;
+	}
+
+	bool CoverSolver::IsWithinBudget(SearchState &state)
+	{
+		if (stopped)
+			return false;
+		// The shared counter and the clock are only consulted once per batch of nodes
+		constexpr ullong NODE_BATCH = 256;
+		if (++state.nNodes % NODE_BATCH != 0)
+			return true;
+		ullong total = nNodes += NODE_BATCH;
+		if ((nodeBudget != 0 && total >= nodeBudget) ||
+			(deadline != std::chrono::steady_clock::time_point::max() && std::chrono::steady_clock::now() >= deadline))
+			stopped = true;
+		return !stopped;
+	}
+
+	int CoverSolver::GetMinimumCost() const
+	{
+		return bestCost;
+	}
+
+	void CoverSolver::StartEnumeration(int cost)
+	{
+		targetCost = cost;
+		enumerationState = CreateState();
+		frames.clear();
+		started = false;
+	}
+
+	int CoverSolver::Enter(int cost, size_t depth)
+	{
+		SearchState &state = enumerationState;
+		size_t nWords = matrix.GetWordCount();
+		const ullong *coveredColumns = state.covered.data() + depth * nWords;
+		if (matrix.IsFull(coveredColumns))
+			return cost == targetCost ? 1 : 0;
+		if (cost > targetCost || targetCost - cost < LowerBound(state, coveredColumns))
+			return 0;
+		size_t column = 0, minRows = std::numeric_limits<size_t>::max();
+		ForEachUncovered(coveredColumns, [&](size_t j) {
+			size_t nRows = std::count_if(columnRows[j].begin(), columnRows[j].end(), [&state](size_t row) {
+				return !state.excluded[row];
+			});
+			if (nRows < minRows)
+				minRows = nRows, column = j;
+		});
+		if (minRows == 0)
+			return 0;
+		frames.push_back(Frame{column, 0, cost, false, {}});
+		return 2;
+	}
+
+	bool CoverSolver::NextCover(std::vector<size_t> &cover)
+	{
+		SearchState &state = enumerationState;
+		size_t nWords = matrix.GetWordCount();
+		int result = 0;
+		if (!started)
+		{
+			started = true;
+			result = Enter(0, 0);
+		}
+		// The frames replay Search() step by step, so it can be left whenever a cover is found
+		while (result != 1 && !frames.empty())
+		{
+			size_t depth = frames.size() - 1;
+			Frame &frame = frames.back();
+			const auto &rows = columnRows[frame.column];
+			if (frame.hasChild)
+			{ // The previous branch has been explored, its row is excluded from the following ones
+				size_t row = state.chosen.back();
+				state.chosen.pop_back();
+				state.excluded[row] = true;
+				frame.newlyExcluded.push_back(row);
+				frame.hasChild = false;
+			}
+			while (frame.next < rows.size() && state.excluded[rows[frame.next]])
+				++frame.next;
+			if (frame.next == rows.size())
+			{
+				for (auto row : frame.newlyExcluded)
+					state.excluded[row] = false;
+				frames.pop_back();
+				continue;
+			}
+			size_t row = rows[frame.next++];
+			frame.hasChild = true;
+			CoverageMatrix::Or(state.covered.data() + (depth + 1) * nWords, state.covered.data() + depth * nWords,
+							   matrix.Row(row), nWords);
+			state.chosen.push_back(row);
+			result = Enter(frame.cost + rowCost[row], depth + 1);
+		}
+		if (result != 1)
+			return false;
+		cover = state.chosen;
+		for (auto &row : cover)
+			row = rowIds[row];
+		std::sort(cover.begin(), cover.end());
+		return true;
+	}
+
+	BDDManager::Node CoverSolver::GetCoverFamily(BDDManager &manager, int cost)
+	{
+		SearchState state = CreateState();
+		FamilyMemo memo;
+		return BuildCoverFamily(manager, state, cost, 0, memo);
+	}
+
+	BDDManager::Node CoverSolver::BuildCoverFamily(BDDManager &manager, SearchState &state, int remainingCost,
+													size_t depth, FamilyMemo &memo)
+	{
+		size_t nWords = matrix.GetWordCount();
+		const ullong *coveredColumns = state.covered.data() + depth * nWords;
+		// Since the cost is minimal, a path never chooses a row that is redundant, so the sets found
+		// below a path never contain its rows and no covered column is left with any cost to spend
+		if (matrix.IsFull(coveredColumns))
+			return remainingCost == 0 ? BDDManager::ONE : BDDManager::ZERO;
+		if (remainingCost < LowerBound(state, coveredColumns))
+			return BDDManager::ZERO;
+		auto key = std::make_pair(remainingCost, std::vector<ullong>(coveredColumns, coveredColumns + nWords));
+		auto it = memo.find(key);
+		if (it != memo.end())
+			return it->second;
+		size_t column = 0, minRows = std::numeric_limits<size_t>::max();
+		ForEachUncovered(coveredColumns, [&](size_t j) {
+			if (columnRows[j].size() < minRows)
+				minRows = columnRows[j].size(), column = j;
+		});
+		// Every cover contains one of the rows of the column, each of which adds itself to the covers of the rest
+		BDDManager::Node family = BDDManager::ZERO;
+		ullong *nextCovered = state.covered.data() + (depth + 1) * nWords;
+		for (auto row : columnRows[column])
+		{
+			if (rowCost[row] > remainingCost)
+				continue;
+			CoverageMatrix::Or(nextCovered, coveredColumns, matrix.Row(row), nWords);
+			auto rest = BuildCoverFamily(manager, state, remainingCost - rowCost[row], depth + 1, memo);
+			family = manager.Union(family, manager.Change(rest, static_cast<uint32_t>(rowIds[row])));
+		}
+		return memo[key] = family;
+	}
+
+	template<class Function>
+	void CoverSolver::ForEachUncovered(const ullong *coveredColumns, Function function) const
+	{
+		for (size_t i = 0; i * 64 < columnRows.size(); ++i)
+		{
+			ullong word = ~coveredColumns[i];
+			if (columnRows.size() - i * 64 < 64)
+				word &= (1ULL << (columnRows.size() - i * 64)) - 1;
+			for (; word; word &= word - 1)
+				function(i * 64 + numeric::CountTrailingZeros(word));
+		}
+	}
+
+	void CoverSolver::Search(SearchState &state, int cost, size_t depth, TaskPool *pool)
+	{
+		size_t nWords = matrix.GetWordCount();
+		const ullong *coveredColumns = state.covered.data() + depth * nWords;
+		if (!IsWithinBudget(state))
+			return;
+		int best = bestCost;
+		if (matrix.IsFull(coveredColumns))
+		{
+			if (cost > best || (!findAll && cost == best))
+				return;
+			while (cost < best && !bestCost.compare_exchange_weak(best, cost));
+			if (!findAll)
+			{ // Only the last improvement is kept
+				state.solutionCost = cost;
+				state.solutions.assign(1, state.chosen);
+				return;
+			}
+			if (state.solutions.empty() || cost < state.solutionCost)
+			{ // All covers found so far by this thread are more expensive than this one
+				state.solutionCost = cost;
+				state.solutions.clear();
+			}
+			state.solutions.push_back(state.chosen);
+			return;
+		}
+		// Covers of the same cost as the incumbent must not be pruned if all of them are needed.
+		// The bound is widened, since it is the largest int if some column can't be covered
+		if (cost > best || best - cost < static_cast<long long>(LowerBound(state, coveredColumns)) + (findAll ? 0 : 1))
+			return;
+		// Branch on the uncovered column that is the hardest to cover
+		size_t column = 0, minRows = std::numeric_limits<size_t>::max();
+		ForEachUncovered(coveredColumns, [&](size_t j) {
+			size_t nRows = std::count_if(columnRows[j].begin(), columnRows[j].end(), [&state](size_t row) {
+				return !state.excluded[row];
+			});
+			if (nRows < minRows)
+				minRows = nRows, column = j;
+		});
+		if (minRows == 0)
+			return;
+		/* The i-th branch chooses the i-th row that covers this column and excludes all previous rows
+		 * from further consideration. This way every combination of rows is visited at most once. */
+		std::vector<size_t> newlyExcluded;
+		ullong *nextCovered = state.covered.data() + (depth + 1) * nWords;
+		for (auto row : columnRows[column])
+		{
+			if (state.excluded[row])
+				continue;
+			if (pool != nullptr && pool->IsStarving(state.thread))
+			{ // The branch is handed out to another thread, along with the rows it must not choose
+				Task task{state.chosen, {}, cost + rowCost[row]};
+				task.chosen.push_back(row);
+				for (size_t i = 0; i < state.excluded.size(); ++i)
+					if (state.excluded[i])
+						task.excluded.push_back(i);
+				pool->Push(state.thread, std::move(task));
+			}
+			else
+			{
+				CoverageMatrix::Or(nextCovered, coveredColumns, matrix.Row(row), nWords);
+				state.chosen.push_back(row);
+				Search(state, cost + rowCost[row], depth + 1, pool);
+				state.chosen.pop_back();
+			}
+			state.excluded[row] = true;
+			newlyExcluded.push_back(row);
+		}
+		for (auto row : newlyExcluded)
+			state.excluded[row] = false;
+	}
+
+	int CoverSolver::LowerBound(SearchState &state, const ullong *coveredColumns) const
+	{
+		// Independent columns have no rows in common, so each of them needs a distinct row.
+		// The columns are considered in the order they appear, rows of chosen columns are marked.
+		++state.stamp;
+		int bound = 0;
+		bool coverable = true;
+		ForEachUncovered(coveredColumns, [&](size_t j) {
+			if (!coverable)
+				return;
+			int minCost = std::numeric_limits<int>::max();
+			for (auto row : columnRows[j])
+				if (!state.excluded[row])
+				{
+					if (state.rowStamp[row] == state.stamp)
+						return;
+					minCost = std::min(minCost, rowCost[row]);
+				}
+			if (minCost == std::numeric_limits<int>::max())
+			{ // This column can't be covered at all
+				coverable = false;
+				return;
+			}
+			bound += minCost;
+			for (auto row : columnRows[j])
+				state.rowStamp[row] = state.stamp;
+		});
+		return coverable ? bound : std::numeric_limits<int>::max();
+	}
+}
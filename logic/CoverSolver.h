@@ -0,0 +1,226 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <vector>
+
+#include "BDD.h"
+#include "ImplicantTable.h"
+#include "CoverTable.h"
+#include "CoverageMatrix.h"
+
+namespace logic
+{
+	/**
+	 * Exact solver for the minimum cover problem that arises when selecting
+	 * prime implicants for a minimal disjunctive normal form.
+	 *
+	 * The cover table has a row for each prime implicant and a column for each minterm.
+	 * The cost of a row is the number of letters of its implicant. The solver performs
+	 * a branch and bound search: it branches on the uncovered minterm that is covered by
+	 * the fewest remaining implicants, and prunes any branch whose cost, increased by a lower bound
+	 * for the uncovered minterms, exceeds the cost of the best cover found so far (the incumbent).
+	 * The lower bound is obtained from a maximal independent set of uncovered minterms,
+	 * i.e. minterms no two of which are covered by the same implicant.
+	 */
+	class CoverSolver
+	{
+		// Rows and columns are renumbered, rowIds maps the new row indices to those of the cover table
+		std::vector<size_t> rowIds;
+		std::vector<int> rowCost;
+		// Columns covered by each row and rows that cover each column
+		std::vector<std::vector<size_t>> rowColumns, columnRows;
+		CoverageMatrix matrix{0, 0};
+
+		/**
+		 * State of one thread of the search. The columns covered at depth d of the search are stored in
+		 * the d-th block of matrix.GetWordCount() words of "covered".
+		 */
+		struct SearchState
+		{
+			std::vector<ullong> covered;
+			std::vector<bool> excluded;
+			std::vector<size_t> chosen;
+			// Covers found by this thread and their cost, which may be above the global best
+			std::vector<std::vector<size_t>> solutions;
+			int solutionCost;
+			// Marks used by LowerBound(). A row is marked if its stamp equals the current stamp.
+			std::vector<unsigned> rowStamp;
+			unsigned stamp = 0;
+			// Index of the thread, which is also the index of its queue in the task pool
+			unsigned thread = 0;
+			// Number of nodes visited by this thread
+			ullong nNodes = 0;
+		};
+
+		/**
+		 * A subtree of the search that has not been explored yet: the chosen rows, the rows
+		 * excluded by earlier siblings and ancestors, and the cost of the chosen rows.
+		 */
+		struct Task
+		{
+			std::vector<size_t> chosen, excluded;
+			int cost;
+		};
+
+		class TaskPool;
+
+		// Cost of the best cover found so far by any thread
+		std::atomic<int> bestCost;
+		// Whether the search looks for all covers of minimum cost or just for the minimum cost
+		bool findAll = true;
+		// Limits of the search. Once one of them is reached, "stopped" is set and all threads return.
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+		ullong nodeBudget = 0;
+		std::atomic<ullong> nNodes{0};
+		std::atomic<bool> stopped{false};
+
+		/**
+		 * A node of the search tree in the lazy enumeration: the column it branches on, the position
+		 * of the next row to try, and the rows excluded by the branches that have already been explored.
+		 */
+		struct Frame
+		{
+			size_t column, next;
+			int cost;
+			bool hasChild;
+			std::vector<size_t> newlyExcluded;
+		};
+
+		// State of the lazy enumeration
+		SearchState enumerationState;
+		std::vector<Frame> frames;
+		int targetCost = 0;
+		bool started = false;
+
+		SearchState CreateState() const;
+
+		void Search(SearchState &state, int cost, size_t depth, TaskPool *pool);
+
+		/**
+		 * Runs the search on <code>nThreads</code> threads.
+		 * @param upperBound - Initial value of the best cost. Only covers that are not more expensive are found.
+		 * @return The final states of the threads.
+		 */
+		std::vector<SearchState> RunSearch(unsigned nThreads, bool findAll, int upperBound);
+
+		/**
+		 * Counts a node visited by <code>state</code> against the limits of the search.
+		 * @return Whether the search may go on.
+		 */
+		bool IsWithinBudget(SearchState &state);
+
+		/**
+		 * Enters a node of the lazy enumeration whose chosen rows are already in the enumeration state.
+		 * @return 1 if the node is a cover of the target cost, 2 if a frame has been pushed for it, and 0 otherwise.
+		 */
+		int Enter(int cost, size_t depth);
+
+		// Families of the covers of the uncovered columns of a set of covered columns at a remaining cost
+		using FamilyMemo = std::map<std::pair<int, std::vector<ullong>>, BDDManager::Node>;
+
+		/**
+		 * @return ZDD of the sets of rows of exactly <code>remainingCost</code> that cover the columns
+		 * which are not covered at <code>depth</code> of <code>state</code>.
+		 */
+		BDDManager::Node BuildCoverFamily(BDDManager &manager, SearchState &state, int remainingCost, size_t depth,
+										  FamilyMemo &memo);
+
+		/**
+		 * Explores the subtree described by <code>task</code> with the depth 0 block of <code>state</code>.
+		 */
+		void Run(SearchState &state, const Task &task, TaskPool *pool);
+
+		/**
+		 * Calls <code>function</code> with the index of each column that is not set in <code>coveredColumns</code>.
+		 */
+		template<class Function>
+		void ForEachUncovered(const ullong *coveredColumns, Function function) const;
+
+		/**
+		 * @return Lower bound for the cost of covering all columns that are not set in <code>coveredColumns</code>.
+		 */
+		int LowerBound(SearchState &state, const ullong *coveredColumns) const;
+
+	public:
+		/**
+		 * @param primeImplicants - Implicants that may be used in a cover (rows of the cover table).
+		 * @param minterms - Indices of minterms that have to be covered (columns of the cover table).
+		 */
+		CoverSolver(const ImplicantTable &primeImplicants, const std::vector<ullong> &minterms);
+
+		/**
+		 * Creates a solver for the active rows and columns of <code>table</code>.
+		 * Essential rows of the table are not part of the covers returned by <code>Solve()</code>.
+		 */
+		explicit CoverSolver(const CoverTable &table);
+
+		/**
+		 * Finds all covers of minimum cost. With more than one thread, the search tree is split into tasks
+		 * that are distributed over a work-stealing pool: a thread that runs out of tasks steals from the others,
+		 * and busy threads hand out their remaining branches while some thread is idle. All threads prune
+		 * against the best cost found by any of them, and idle threads sleep until there is a task. Tables with few
+		 * columns are always searched on a single thread. The result does not depend on the number of threads.
+		 * @param nThreads - Number of threads, 0 and 1 meaning a serial search.
+		 * @return Indices of the implicants (rows of the cover table) that form each cover, sorted in ascending order.
+		 * Covers are sorted lexicographically. If the minterms can't be covered, the result is empty.
+		 * @note Implicants are assumed to contain at least one letter, which guarantees
+		 * that every cover of minimum cost is irredundant.
+		 */
+		std::vector<std::vector<size_t>> Solve(unsigned nThreads = 1);
+
+		/**
+		 * Finds the minimum cost of a cover without collecting the covers, which lets the search prune
+		 * every branch that can't beat the incumbent.
+		 * @return The minimum cost, or <code>std::numeric_limits<int>::max()</code> if the minterms can't be covered.
+		 */
+		int FindMinimumCost(unsigned nThreads = 1);
+
+		/**
+		 * Searches for a single cover that is cheaper than <code>upperBound</code>, until the search
+		 * either finishes or reaches one of its limits. Each improvement tightens the bound, so the search
+		 * can be stopped at any time with the best cover found so far.
+		 * @param cover - Will contain the indices of the rows of the cheapest cover found, sorted in ascending order.
+		 * Left unchanged if no cover is cheaper than <code>upperBound</code>.
+		 * @param upperBound - Cost of a known cover, e.g. a greedy one.
+		 * @param deadline - Point in time at which the search stops.
+		 * @param nodeBudget - Maximum number of visited nodes, 0 meaning no limit. It is checked in batches of nodes.
+		 * @return Whether the search has finished, which proves that the result is a cover of minimum cost.
+		 */
+		bool FindMinimumCover(std::vector<size_t> &cover, int upperBound,
+							  std::chrono::steady_clock::time_point deadline, ullong nodeBudget = 0,
+							  unsigned nThreads = 1);
+
+		/**
+		 * @return The cost of the covers returned by the last call to <code>Solve()</code>, <code>FindMinimumCost()</code>
+		 * or <code>FindMinimumCover()</code>.
+		 */
+		int GetMinimumCost() const;
+
+		/**
+		 * Builds a ZDD of all covers of the given cost, which must be the minimum cost, e.g. the result of
+		 * <code>FindMinimumCost()</code>. Variable <code>i</code> of the ZDD is row <code>i</code> of the cover table.
+		 * Unlike <code>Solve()</code>, the search doesn't exclude rows of earlier branches, so that it only depends
+		 * on the covered columns and the remaining cost. Subtrees that are reached again along another path
+		 * are then taken from a memo, and covers found along several paths are merged by the ZDD.
+		 * The time and memory this takes depend on the number of distinct subproblems rather than on the number
+		 * of covers.
+		 */
+		BDDManager::Node GetCoverFamily(BDDManager &manager, int cost);
+
+		/**
+		 * Starts a lazy enumeration of the covers of the given cost, which should be the minimum cost.
+		 * The covers are then retrieved one at a time with <code>NextCover()</code>.
+		 */
+		void StartEnumeration(int cost);
+
+		/**
+		 * Resumes the enumeration until the next cover is found. Covers come in the order of the search,
+		 * which is deterministic, but they are not sorted.
+		 * @param cover - Will contain the indices of the rows of the cover, sorted in ascending order.
+		 * @return <code>false</code> if there are no more covers.
+		 */
+		bool NextCover(std::vector<size_t> &cover);
+	};
+}
@@ -0,0 +1,242 @@
+#include <algorithm>
+
+#include "CoverTable.h"
+#include "../numeric/NumericGeneral.h"
+
+namespace logic
+{
+	CoverTable::CoverTable(const ImplicantTable &primeImplicants, const std::vector<ullong> &minterms)
+			: rowCost(primeImplicants.GetSize()), rowColumns(primeImplicants.GetSize()), columnRows(minterms.size()),
+			  rowActive(primeImplicants.GetSize(), true), columnActive(minterms.size(), true)
+	{
+		for (size_t i = 0; i < primeImplicants.GetSize(); ++i)
+		{
+			ullong form = primeImplicants.GetForm(i), mask = primeImplicants.GetMask(i);
+			rowCost[i] = numeric::PopCount(mask);
+			for (size_t j = 0; j < minterms.size(); ++j)
+				if ((minterms[j] & mask) == form)
+				{
+					rowColumns[i].push_back(j);
+					columnRows[j].push_back(i);
+				}
+		}
+	}
+
+	CoverTable::CoverTable(std::vector<int> rowCost, std::vector<std::vector<size_t>> rowColumns, size_t nColumns)
+			: rowCost(std::move(rowCost)), rowColumns(std::move(rowColumns)), columnRows(nColumns),
+			  rowActive(CoverTable::rowColumns.size(), true), columnActive(nColumns, true)
+	{
+		for (size_t i = 0; i < CoverTable::rowColumns.size(); ++i)
+			for (auto column : CoverTable::rowColumns[i])
+				columnRows[column].push_back(i);
+	}
+
+	void CoverTable::RemoveRow(size_t row)
+	{
+		rowActive[row] = false;
+		for (auto column : rowColumns[row])
+		{
+			auto &rows = columnRows[column];
+			rows.erase(std::lower_bound(rows.begin(), rows.end(), row));
+		}
+		rowColumns[row].clear();
+	}
+
+	void CoverTable::RemoveColumn(size_t column)
+	{
+		columnActive[column] = false;
+		for (auto row : columnRows[column])
+		{
+			auto &columns = rowColumns[row];
+			columns.erase(std::lower_bound(columns.begin(), columns.end(), column));
+		}
+		columnRows[column].clear();
+	}
+
+	bool CoverTable::ExtractEssentialRows()
+	{
+		bool changed = false;
+		for (size_t j = 0; j < columnRows.size(); ++j)
+			if (columnActive[j] && columnRows[j].size() == 1)
+			{
+				size_t row = columnRows[j][0];
+				essentialRows.push_back(row);
+				// Like RemoveColumn for each column of the row, except that the row's own list is cleared once at the end
+				// instead of being erased from column by column, which is quadratic in the length of the row
+				for (auto column : rowColumns[row])
+				{
+					columnActive[column] = false;
+					for (auto other : columnRows[column])
+						if (other != row)
+						{
+							auto &columns = rowColumns[other];
+							columns.erase(std::lower_bound(columns.begin(), columns.end(), column));
+						}
+					columnRows[column].clear();
+				}
+				rowColumns[row].clear();
+				rowActive[row] = false;
+				changed = true;
+			}
+		return changed;
+	}
+
+	bool CoverTable::RemoveDominatedRows()
+	{
+		bool changed = false;
+		for (size_t i = 0; i < rowColumns.size(); ++i)
+		{
+			if (!rowActive[i])
+				continue;
+			if (rowColumns[i].empty())
+			{
+				RemoveRow(i);
+				changed = true;
+				continue;
+			}
+			// A dominating row has to cover the first column of this row
+			for (auto other : columnRows[rowColumns[i][0]])
+				if (other != i && rowCost[other] < rowCost[i] &&
+					std::includes(rowColumns[other].begin(), rowColumns[other].end(),
+								  rowColumns[i].begin(), rowColumns[i].end()))
+				{
+					RemoveRow(i);
+					changed = true;
+					break;
+				}
+		}
+		return changed;
+	}
+
+	bool CoverTable::RemoveDominatingColumns()
+	{
+		bool changed = false;
+		for (size_t j = 0; j < columnRows.size(); ++j)
+		{
+			if (!columnActive[j] || columnRows[j].empty())
+				continue;
+			// A dominated column has to be covered by the first row of this column
+			for (auto other : rowColumns[columnRows[j][0]])
+				if (other != j && columnRows[other].size() <= columnRows[j].size() &&
+					std::includes(columnRows[j].begin(), columnRows[j].end(),
+								  columnRows[other].begin(), columnRows[other].end()))
+				{
+					// Of two identical columns, the one that comes first is kept
+					if (columnRows[other].size() == columnRows[j].size() && other > j)
+						continue;
+					RemoveColumn(j);
+					changed = true;
+					break;
+				}
+		}
+		return changed;
+	}
+
+	void CoverTable::Reduce()
+	{
+		bool changed = true;
+		while (changed)
+		{
+			changed = ExtractEssentialRows();
+			changed = RemoveDominatedRows() || changed;
+			changed = RemoveDominatingColumns() || changed;
+		}
+	}
+
+	std::vector<size_t> CoverTable::GetGreedyCover() const
+	{
+		std::vector<size_t> cover;
+		std::vector<bool> covered(columnRows.size(), false);
+		size_t nUncovered = std::count(columnActive.begin(), columnActive.end(), true);
+		while (nUncovered > 0)
+		{
+			size_t bestRow = rowColumns.size(), bestCount = 0;
+			double bestScore = 0;
+			for (size_t i = 0; i < rowColumns.size(); ++i)
+			{
+				if (!rowActive[i])
+					continue;
+				size_t count = std::count_if(rowColumns[i].begin(), rowColumns[i].end(), [&covered](size_t j) {
+					return !covered[j];
+				});
+				double score = (double) count / std::max(rowCost[i], 1);
+				if (count > 0 && score > bestScore)
+					bestRow = i, bestCount = count, bestScore = score;
+			}
+			if (bestRow == rowColumns.size())
+				break;
+			for (auto column : rowColumns[bestRow])
+				covered[column] = true;
+			nUncovered -= bestCount;
+			cover.push_back(bestRow);
+		}
+		// A row is redundant if every column it covers is also covered by another selected row
+		std::vector<size_t> nCovering(columnRows.size(), 0);
+		for (auto row : cover)
+			for (auto column : rowColumns[row])
+				++nCovering[column];
+		std::stable_sort(cover.begin(), cover.end(), [this](size_t x, size_t y) {
+			return rowCost[x] > rowCost[y];
+		});
+		std::vector<size_t> irredundant;
+		for (auto row : cover)
+			if (std::all_of(rowColumns[row].begin(), rowColumns[row].end(), [&nCovering](size_t j) {
+				return nCovering[j] > 1;
+			}))
+			{
+				for (auto column : rowColumns[row])
+					--nCovering[column];
+			}
+			else
+				irredundant.push_back(row);
+		std::sort(irredundant.begin(), irredundant.end());
+		return irredundant;
+	}
+
+	size_t CoverTable::GetRowCount() const
+	{
+		return rowColumns.size();
+	}
+
+	size_t CoverTable::GetColumnCount() const
+	{
+		return columnRows.size();
+	}
+
+	int CoverTable::GetRowCost(size_t row) const
+	{
+		return rowCost[row];
+	}
+
+	bool CoverTable::IsRowActive(size_t row) const
+	{
+		return rowActive[row];
+	}
+
+	bool CoverTable::IsColumnActive(size_t column) const
+	{
+		return columnActive[column];
+	}
+
+	const std::vector<size_t> &CoverTable::GetRowColumns(size_t row) const
+	{
+		return rowColumns[row];
+	}
+
+	const std::vector<size_t> &CoverTable::GetColumnRows(size_t column) const
+	{
+		return columnRows[column];
+	}
+
+	const std::vector<size_t> &CoverTable::GetEssentialRows() const
+	{
+		return essentialRows;
+	}
+
+	bool CoverTable::IsSolved() const
+	{
+		return std::none_of(columnActive.begin(), columnActive.end(), [](bool active) {
+			return active;
+		});
+	}
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vector>
+
+#include "ImplicantTable.h"
+
+namespace logic
+{
+	/**
+	 * Prime implicant chart: a row for each prime implicant and a column for each minterm
+	 * that has to be covered. The cost of a row is the number of letters of its implicant.
+	 *
+	 * <code>Reduce()</code> simplifies the table to its cyclic core, while preserving the set
+	 * of all covers of minimum cost.
+	 */
+	class CoverTable
+	{
+		std::vector<int> rowCost;
+		// Sorted indices of active columns covered by each row and of active rows that cover each column
+		std::vector<std::vector<size_t>> rowColumns, columnRows;
+		std::vector<bool> rowActive, columnActive;
+		std::vector<size_t> essentialRows;
+
+		void RemoveRow(size_t row);
+
+		void RemoveColumn(size_t column);
+
+		/**
+		 * Selects the only row that covers a column and removes it along with all the columns it covers.
+		 * @return Whether any row was selected.
+		 */
+		bool ExtractEssentialRows();
+
+		/**
+		 * Removes each row whose columns are also covered by a single cheaper row,
+		 * as well as rows that don't cover any column.
+		 * @note Rows of equal cost are kept, since they may appear in different minimum covers.
+		 * @return Whether any row was removed.
+		 */
+		bool RemoveDominatedRows();
+
+		/**
+		 * Removes each column that is covered by every row that covers some other column.
+		 * Any cover of the other column then necessarily covers this one.
+		 * @return Whether any column was removed.
+		 */
+		bool RemoveDominatingColumns();
+
+	public:
+		/**
+		 * @param primeImplicants - Rows of the table.
+		 * @param minterms - Indices of minterms, columns of the table.
+		 */
+		CoverTable(const ImplicantTable &primeImplicants, const std::vector<ullong> &minterms);
+
+		/**
+		 * Creates a table whose rows are already known, e.g. because they are kept up to date between minimizations.
+		 * @param rowCost - Cost of each row.
+		 * @param rowColumns - Indices of the columns covered by each row, in ascending order.
+		 * @param nColumns - Number of columns.
+		 */
+		CoverTable(std::vector<int> rowCost, std::vector<std::vector<size_t>> rowColumns, size_t nColumns);
+
+		/**
+		 * Repeats essential row extraction, dominated row removal and dominating column removal
+		 * until none of them changes the table.
+		 */
+		void Reduce();
+
+		/**
+		 * Covers the active columns greedily: each step selects the active row that covers the most
+		 * uncovered columns per letter. Selected rows that turn out to be redundant are dropped afterwards,
+		 * the most expensive ones first.
+		 * @return Selected rows in ascending order, not including the essential rows.
+		 */
+		std::vector<size_t> GetGreedyCover() const;
+
+		// Getters
+
+		size_t GetRowCount() const;
+
+		size_t GetColumnCount() const;
+
+		int GetRowCost(size_t row) const;
+
+		bool IsRowActive(size_t row) const;
+
+		bool IsColumnActive(size_t column) const;
+
+		/** @return Active columns covered by <code>row</code>. */
+		const std::vector<size_t> &GetRowColumns(size_t row) const;
+
+		/** @return Active rows that cover <code>column</code>. */
+		const std::vector<size_t> &GetColumnRows(size_t column) const;
+
+		/** @return Rows that have been selected as essential by <code>Reduce()</code>. */
+		const std::vector<size_t> &GetEssentialRows() const;
+
+		/** @return Whether all columns have been covered by essential rows. */
+		bool IsSolved() const;
+	};
+}
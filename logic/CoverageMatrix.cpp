@@ -0,0 +1,126 @@
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "CoverageMatrix.h"
+
+// On x86 with GCC or Clang, the AVX2 kernels are compiled for that target alone and chosen at run time,
+// so the same binary runs on processors without AVX2
+#if !defined(__AVX2__) && defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define ACPP_AVX2_DISPATCH
+#endif
+
+namespace logic
+{
+#if defined(__AVX2__) || defined(ACPP_AVX2_DISPATCH)
+#ifdef ACPP_AVX2_DISPATCH
+	__attribute__((target("avx2")))
+#endif
+	static bool _IsFullAVX2(const ullong *x, const ullong *full, size_t nWords)
+	{
+		for (size_t i = 0; i < nWords; i += 4)
+		{
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + i));
+			__m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(full + i));
+			// testc checks that (~a & f) == 0
+			if (!_mm256_testc_si256(a, f))
+				return false;
+		}
+		return true;
+	}
+
+#ifdef ACPP_AVX2_DISPATCH
+	__attribute__((target("avx2")))
+#endif
+	static void _OrAVX2(ullong *destination, const ullong *x, const ullong *y, size_t nWords)
+	{
+		for (size_t i = 0; i < nWords; i += 4)
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_or_si256(
+					_mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + i)),
+					_mm256_loadu_si256(reinterpret_cast<const __m256i *>(y + i))));
+	}
+#endif
+
+#ifdef ACPP_AVX2_DISPATCH
+	static bool _HasAVX2()
+	{
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+	}
+
+	static const bool hasAVX2 = _HasAVX2();
+#endif
+
+	CoverageMatrix::CoverageMatrix(size_t nRows, size_t nColumns)
+			: nRows(nRows), nColumns(nColumns),
+			  nWords(((nColumns + 63) / 64 + WORD_ALIGNMENT - 1) / WORD_ALIGNMENT * WORD_ALIGNMENT),
+			  bits(nRows * nWords, 0), full(nWords, 0)
+	{
+		for (size_t j = 0; j < nColumns; ++j)
+			full[j / 64] |= 1ULL << (j % 64);
+	}
+
+	void CoverageMatrix::Set(size_t row, size_t column)
+	{
+		bits[row * nWords + column / 64] |= 1ULL << (column % 64);
+	}
+
+	size_t CoverageMatrix::GetRowCount() const
+	{
+		return nRows;
+	}
+
+	size_t CoverageMatrix::GetColumnCount() const
+	{
+		return nColumns;
+	}
+
+	size_t CoverageMatrix::GetWordCount() const
+	{
+		return nWords;
+	}
+
+	bool CoverageMatrix::IsFull(const ullong *x) const
+	{
+#if defined(__AVX2__)
+		return _IsFullAVX2(x, full.data(), nWords);
+#elif defined(__SSE2__)
+#ifdef ACPP_AVX2_DISPATCH
+		if (hasAVX2)
+			return _IsFullAVX2(x, full.data(), nWords);
+#endif
+		for (size_t i = 0; i < nWords; i += 2)
+		{
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(x + i));
+			__m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i *>(full.data() + i));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(a, f), f)) != 0xFFFF)
+				return false;
+		}
+		return true;
+#else
+		for (size_t i = 0; i < nWords; ++i)
+			if (~x[i] & full[i])
+				return false;
+		return true;
+#endif
+	}
+
+	void CoverageMatrix::Or(ullong *destination, const ullong *x, const ullong *y, size_t nWords)
+	{
+#if defined(__AVX2__)
+		_OrAVX2(destination, x, y, nWords);
+#elif defined(__SSE2__)
+#ifdef ACPP_AVX2_DISPATCH
+		if (hasAVX2)
+			return _OrAVX2(destination, x, y, nWords);
+#endif
+		for (size_t i = 0; i < nWords; i += 2)
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_or_si128(
+					_mm_loadu_si128(reinterpret_cast<const __m128i *>(x + i)),
+					_mm_loadu_si128(reinterpret_cast<const __m128i *>(y + i))));
+#else
+		for (size_t i = 0; i < nWords; ++i)
+			destination[i] = x[i] | y[i];
+#endif
+	}
+}
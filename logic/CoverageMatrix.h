@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../symbols.h"
+
+namespace logic
+{
+	/**
+	 * Bit matrix that stores, for each implicant (row), the set of minterms (columns) it covers.
+	 * Each row is padded to a multiple of <code>WORD_ALIGNMENT</code> 64-bit words, so whole rows
+	 * can be processed with vector instructions. SSE2 kernels are used when the compiler targets them,
+	 * with a scalar fallback otherwise. The AVX2 kernels are always built with GCC and Clang on x86
+	 * and are used if the processor supports them, unless the whole program targets AVX2 anyway.
+	 */
+	class CoverageMatrix
+	{
+	public:
+		static constexpr size_t WORD_ALIGNMENT = 4;
+
+	private:
+		size_t nRows, nColumns, nWords;
+		std::vector<ullong> bits;
+		// Has a set bit for every column, padding bits are clear
+		std::vector<ullong> full;
+
+	public:
+		CoverageMatrix(size_t nRows, size_t nColumns);
+
+		/** Marks <code>column</code> as covered by <code>row</code>. */
+		void Set(size_t row, size_t column);
+
+		size_t GetRowCount() const;
+
+		size_t GetColumnCount() const;
+
+		/** @return The number of 64-bit words in a row, including padding. */
+		size_t GetWordCount() const;
+
+		/** @return Pointer to the first word of <code>row</code>. */
+		const ullong *Row(size_t row) const
+		{ return bits.data() + row * nWords; }
+
+		/**
+		 * @param x - Bitset of <code>GetWordCount()</code> words.
+		 * @return Whether all bits of <code>x</code> that represent columns are set.
+		 */
+		bool IsFull(const ullong *x) const;
+
+		/**
+		 * Stores the bitwise or of <code>x</code> and <code>y</code> into <code>destination</code>.
+		 * @param nWords - Number of words, must be a multiple of <code>WORD_ALIGNMENT</code>.
+		 */
+		static void Or(ullong *destination, const ullong *x, const ullong *y, size_t nWords);
+	};
+}
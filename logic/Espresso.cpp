@@ -0,0 +1,336 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Espresso.h"
+#include "../numeric/NumericGeneral.h"
+
+namespace logic
+{
+	Espresso::Espresso(unsigned char nVariables, const DNF &dnf, const DNF &dontCare) : nVariables(nVariables)
+	{
+		if (nVariables == 0 || nVariables > numeric::LONG_LONG_SIZE)
+			throw std::domain_error("Illegal number of variables");
+		ullong mask = full_mask(nVariables);
+		for (auto &implicant : dnf)
+			cover.emplace_back(implicant.GetForm(), implicant.GetMask() & mask);
+		for (auto &implicant : dontCare)
+			Espresso::dontCare.emplace_back(implicant.GetForm(), implicant.GetMask() & mask);
+	}
+
+	std::vector<Implicant> Espresso::Cofactor(const std::vector<Implicant> &cubes, const Implicant &cube)
+	{
+		std::vector<Implicant> result;
+		for (auto &x : cubes)
+		{
+			// The cubes are disjoint if they contain some common variable with opposite signs
+			if ((x.GetMask() & cube.GetMask()) & (x.GetForm() ^ cube.GetForm()))
+				continue;
+			result.emplace_back(x.GetForm(), x.GetMask() & ~cube.GetMask());
+		}
+		return result;
+	}
+
+	bool Espresso::IsTautology(std::vector<Implicant> &stack, size_t begin, ullong variables)
+	{
+		size_t end = stack.size();
+		double volume = 0;
+		ullong positiveVariables = 0, negativeVariables = 0;
+		for (size_t i = begin; i < end; ++i)
+		{
+			ullong mask = stack[i].GetMask() & variables;
+			int nLetters = numeric::PopCount(mask);
+			if (nLetters == 0)
+				return true;
+			volume += std::ldexp(1., -nLetters);
+			positiveVariables |= mask & stack[i].GetForm();
+			negativeVariables |= mask & ~stack[i].GetForm();
+		}
+		// The cubes can't cover the whole space if their volumes don't add up to it
+		if (volume < 1 - 1e-9)
+			return false;
+		// The cover is a tautology iff its cofactor against the opposite literals of all unate variables is
+		ullong unate = positiveVariables ^ negativeVariables;
+		if (unate)
+		{
+			for (size_t i = begin; i < end; ++i)
+				if (!(stack[i].GetMask() & unate))
+					stack.push_back(stack[i]);
+			bool result = IsTautology(stack, end, variables & ~unate);
+			stack.resize(end, stack[begin]);
+			return result;
+		}
+		// Split on the most binate variable
+		ullong binate = positiveVariables & negativeVariables;
+		int positive[numeric::LONG_LONG_SIZE] = {}, negative[numeric::LONG_LONG_SIZE] = {};
+		for (size_t i = begin; i < end; ++i)
+			for (ullong remaining = stack[i].GetMask() & binate; remaining; remaining &= remaining - 1)
+			{
+				int variable = numeric::CountTrailingZeros(remaining);
+				++(stack[i].GetForm() & (1ULL << variable) ? positive : negative)[variable];
+			}
+		int bestBalance = 0, bestTotal = 0;
+		ullong splitVariable = 0;
+		for (ullong remaining = binate; remaining; remaining &= remaining - 1)
+		{
+			int variable = numeric::CountTrailingZeros(remaining);
+			int balance = std::min(positive[variable], negative[variable]), total = positive[variable] + negative[variable];
+			if (balance > bestBalance || (balance == bestBalance && total > bestTotal))
+			{
+				bestBalance = balance;
+				bestTotal = total;
+				splitVariable = 1ULL << variable;
+			}
+		}
+		// The cofactors are pushed on top of the stack and popped once they are checked
+		bool result = true;
+		for (ullong form : {splitVariable, 0ULL})
+		{
+			for (size_t i = begin; i < end; ++i)
+				if (!(stack[i].GetMask() & splitVariable) || (stack[i].GetForm() & splitVariable) == form)
+					stack.push_back(stack[i]);
+			result = IsTautology(stack, end, variables & ~splitVariable);
+			stack.resize(end, stack[begin]);
+			if (!result)
+				break;
+		}
+		return result;
+	}
+
+	bool Espresso::IsTautology(const std::vector<Implicant> &cubes, ullong variables)
+	{
+		std::vector<Implicant> stack(cubes);
+		return IsTautology(stack, 0, variables);
+	}
+
+	std::vector<Implicant> Espresso::CofactorOthers(const Implicant &cube, const std::vector<Implicant> &cubes,
+													size_t skip) const
+	{
+		std::vector<Implicant> result;
+		auto add = [&](const Implicant &x) {
+			if (!((x.GetMask() & cube.GetMask()) & (x.GetForm() ^ cube.GetForm())))
+				result.emplace_back(x.GetForm(), x.GetMask() & ~cube.GetMask());
+		};
+		for (size_t i = 0; i < cubes.size(); ++i)
+			if (i != skip)
+				add(cubes[i]);
+		for (auto &x : dontCare)
+			add(x);
+		return result;
+	}
+
+	bool Espresso::IsCovered(const Implicant &cube, const std::vector<Implicant> &cubes, size_t skip) const
+	{
+		return IsTautology(CofactorOthers(cube, cubes, skip), full_mask(nVariables) & ~cube.GetMask());
+	}
+
+	void Espresso::Expand()
+	{
+		// Larger cubes are expanded first, since they are more likely to cover other cubes
+		std::stable_sort(cover.begin(), cover.end(), [](const Implicant &x, const Implicant &y) {
+			return x.GetVariableCount() < y.GetVariableCount();
+		});
+		std::vector<bool> covered(cover.size(), false);
+		for (size_t i = 0; i < cover.size(); ++i)
+		{
+			if (covered[i])
+				continue;
+			Implicant cube = cover[i];
+			// Literals that are rare in the cover are raised first
+			std::vector<std::pair<size_t, ullong>> literals;
+			for (ullong remaining = cube.GetMask(); remaining; remaining &= remaining - 1)
+			{
+				ullong sampler = remaining & -remaining;
+				size_t frequency = std::count_if(cover.begin(), cover.end(), [&](const Implicant &x) {
+					return (x.GetMask() & sampler) && !((x.GetForm() ^ cube.GetForm()) & sampler);
+				});
+				literals.emplace_back(frequency, sampler);
+			}
+			std::sort(literals.begin(), literals.end());
+			for (auto &literal : literals)
+			{
+				// The cube is already covered, so only the half across the raised literal has to be checked
+				Implicant opposite(cube.GetForm() ^ literal.second, cube.GetMask());
+				if (IsCovered(opposite, cover, cover.size()))
+					cube = Implicant(cube.GetForm() & ~literal.second, cube.GetMask() & ~literal.second);
+			}
+			cover[i] = cube;
+			for (size_t j = 0; j < cover.size(); ++j)
+				if (j != i && !covered[j] && cube.ImpliedBy(cover[j]))
+					covered[j] = true;
+		}
+		std::vector<Implicant> expanded;
+		for (size_t i = 0; i < cover.size(); ++i)
+			if (!covered[i])
+				expanded.push_back(cover[i]);
+		cover = std::move(expanded);
+	}
+
+	void Espresso::Irredundant()
+	{
+		// Smaller cubes are the first candidates for removal
+		std::stable_sort(cover.begin(), cover.end(), [](const Implicant &x, const Implicant &y) {
+			return x.GetVariableCount() > y.GetVariableCount();
+		});
+		for (size_t i = 0; i < cover.size();)
+			if (IsCovered(cover[i], cover, i))
+				cover.erase(cover.begin() + i);
+			else
+				++i;
+	}
+
+	bool Espresso::GetComplementSupercube(std::vector<Implicant> &stack, size_t begin, ullong variables,
+										  Implicant &supercube)
+	{
+		size_t end = stack.size();
+		ullong positiveVariables = 0, negativeVariables = 0;
+		for (size_t i = begin; i < end; ++i)
+		{
+			ullong mask = stack[i].GetMask() & variables;
+			if (!mask)
+				return false;
+			positiveVariables |= mask & stack[i].GetForm();
+			negativeVariables |= mask & ~stack[i].GetForm();
+		}
+		if (begin == end)
+		{
+			supercube = Implicant(0ULL, 0ULL);
+			return true;
+		}
+		// The complement of a single cube is the sum of its negated literals
+		if (end - begin == 1)
+		{
+			ullong mask = stack[begin].GetMask() & variables;
+			supercube = mask & (mask - 1) ? Implicant(0ULL, 0ULL) : Implicant(~stack[begin].GetForm() & mask, mask);
+			return true;
+		}
+		// The complement projects onto the other variables exactly as the complement of the cubes without
+		// unate literals does, and it lies in the opposite half of a unate variable iff the other half is full
+		ullong unate = positiveVariables ^ negativeVariables;
+		if (unate)
+		{
+			for (size_t i = begin; i < end; ++i)
+				if (!(stack[i].GetMask() & unate))
+					stack.push_back(stack[i]);
+			bool nonEmpty = GetComplementSupercube(stack, end, variables & ~unate, supercube);
+			stack.resize(end, stack[begin]);
+			if (!nonEmpty)
+				return false;
+			ullong form = supercube.GetForm(), mask = supercube.GetMask();
+			for (ullong remaining = unate; remaining; remaining &= remaining - 1)
+			{
+				ullong sampler = remaining & -remaining;
+				for (size_t i = begin; i < end; ++i)
+					if (!(stack[i].GetMask() & sampler) || (stack[i].GetForm() & sampler) == (positiveVariables & sampler))
+						stack.push_back(stack[i]);
+				if (IsTautology(stack, end, variables & ~sampler))
+				{
+					form |= negativeVariables & sampler;
+					mask |= sampler;
+				}
+				stack.resize(end, stack[begin]);
+			}
+			supercube = Implicant(form, mask);
+			return true;
+		}
+		// Split on the most binate variable
+		int positive[numeric::LONG_LONG_SIZE] = {}, negative[numeric::LONG_LONG_SIZE] = {};
+		for (size_t i = begin; i < end; ++i)
+			for (ullong remaining = stack[i].GetMask() & variables; remaining; remaining &= remaining - 1)
+			{
+				int variable = numeric::CountTrailingZeros(remaining);
+				++(stack[i].GetForm() & (1ULL << variable) ? positive : negative)[variable];
+			}
+		int bestBalance = 0, bestTotal = 0;
+		ullong splitVariable = 0;
+		for (ullong remaining = positiveVariables & negativeVariables; remaining; remaining &= remaining - 1)
+		{
+			int variable = numeric::CountTrailingZeros(remaining);
+			int balance = std::min(positive[variable], negative[variable]), total = positive[variable] + negative[variable];
+			if (balance > bestBalance || (balance == bestBalance && total > bestTotal))
+			{
+				bestBalance = balance;
+				bestTotal = total;
+				splitVariable = 1ULL << variable;
+			}
+		}
+		bool found = false;
+		for (ullong form : {splitVariable, 0ULL})
+		{
+			for (size_t i = begin; i < end; ++i)
+				if (!(stack[i].GetMask() & splitVariable) || (stack[i].GetForm() & splitVariable) == form)
+					stack.push_back(stack[i]);
+			Implicant half(0ULL, 0ULL);
+			bool nonEmpty = GetComplementSupercube(stack, end, variables & ~splitVariable, half);
+			stack.resize(end, stack[begin]);
+			if (!nonEmpty)
+				continue;
+			half = Implicant(half.GetForm() | form, half.GetMask() | splitVariable);
+			if (found)
+			{
+				// The supercube keeps only the literals on which both halves agree
+				ullong mask = supercube.GetMask() & half.GetMask() & ~(supercube.GetForm() ^ half.GetForm());
+				supercube = Implicant(supercube.GetForm() & mask, mask);
+			}
+			else
+				supercube = half;
+			found = true;
+		}
+		return found;
+	}
+
+	void Espresso::Reduce()
+	{
+		std::stable_sort(cover.begin(), cover.end(), [](const Implicant &x, const Implicant &y) {
+			return x.GetVariableCount() < y.GetVariableCount();
+		});
+		for (size_t i = 0; i < cover.size();)
+		{
+			auto stack = CofactorOthers(cover[i], cover, i);
+			Implicant supercube(0ULL, 0ULL);
+			// A cube whose complement in the rest of the cover is empty is redundant
+			if (!GetComplementSupercube(stack, 0, full_mask(nVariables) & ~cover[i].GetMask(), supercube))
+			{
+				cover.erase(cover.begin() + i);
+				continue;
+			}
+			cover[i] = Implicant(cover[i].GetForm() | supercube.GetForm(), cover[i].GetMask() | supercube.GetMask());
+			++i;
+		}
+	}
+
+	std::pair<size_t, size_t> Espresso::GetCost() const
+	{
+		size_t nLetters = 0;
+		for (auto &cube : cover)
+			nLetters += cube.GetVariableCount();
+		return {cover.size(), nLetters};
+	}
+
+	DNF Espresso::Minimize()
+	{
+		Expand();
+		Irredundant();
+		auto cost = GetCost();
+		for (;;)
+		{
+			auto previous = cover;
+			Reduce();
+			Expand();
+			Irredundant();
+			auto newCost = GetCost();
+			if (newCost >= cost)
+			{
+				if (newCost > cost)
+					cover = std::move(previous);
+				break;
+			}
+			cost = newCost;
+		}
+		return DNF(cover.begin(), cover.end());
+	}
+
+	DNF MinimizeHeuristic(unsigned char nVariables, const DNF &dnf, const DNF &dontCare)
+	{
+		return Espresso(nVariables, dnf, dontCare).Minimize();
+	}
+}
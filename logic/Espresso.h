@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vector>
+
+#include "Implicant.h"
+#include "symbols.h"
+
+namespace logic
+{
+	/**
+	 * Heuristic two-level minimizer in the style of Espresso. It works directly on
+	 * covers of cubes (implicants) and never expands the function into minterms,
+	 * so it can handle functions of up to <code>LONG_LONG_SIZE</code> variables.
+	 * The result is irredundant and consists of prime implicants, but it is not guaranteed to be minimal.
+	 */
+	class Espresso
+	{
+		unsigned char nVariables;
+		std::vector<Implicant> cover, dontCare;
+
+		/**
+		 * @return The cofactor against <code>cube</code> of every cube of <code>cubes</code> except
+		 * the one of index <code>skip</code>, together with the don't care cubes.
+		 */
+		std::vector<Implicant> CofactorOthers(const Implicant &cube, const std::vector<Implicant> &cubes,
+											  size_t skip) const;
+
+		/**
+		 * @return Whether every cube of <code>cubes</code> except the one of index <code>skip</code>,
+		 * together with the don't care cubes, covers <code>cube</code>.
+		 */
+		bool IsCovered(const Implicant &cube, const std::vector<Implicant> &cubes, size_t skip) const;
+
+		/**
+		 * Raises literals of each cube for as long as it stays an implicant of the function,
+		 * then removes the cubes that are contained in the expanded cube.
+		 */
+		void Expand();
+
+		/**
+		 * Removes cubes that are covered by the rest of the cover and the don't care cubes.
+		 */
+		void Irredundant();
+
+		/**
+		 * Replaces each cube by the smallest cube that contains the part of it not covered by the other cubes.
+		 * This moves the cover away from a local minimum before it is expanded again.
+		 */
+		void Reduce();
+
+		/** @return The number of cubes and letters of the current cover, cubes being more significant. */
+		std::pair<size_t, size_t> GetCost() const;
+
+		/**
+		 * Checks whether the cubes from index <code>begin</code> to the end of <code>stack</code> form a tautology.
+		 * Cofactors are pushed onto the stack during the check and popped afterwards, so the recursion
+		 * does not allocate once the stack has grown large enough.
+		 */
+		static bool IsTautology(std::vector<Implicant> &stack, size_t begin, ullong variables);
+
+		/**
+		 * Finds the smallest cube that contains the complement of the cubes from index <code>begin</code>
+		 * to the end of <code>stack</code>, using the stack in the same way as <code>IsTautology</code>.
+		 * @return Whether the complement is non-empty, i.e. whether <code>supercube</code> has been set.
+		 */
+		static bool GetComplementSupercube(std::vector<Implicant> &stack, size_t begin, ullong variables,
+										   Implicant &supercube);
+
+	public:
+		/**
+		 * @param nVariables - Number of variables of the logical function.
+		 * @param dnf - Cubes that form the ON set of the function.
+		 * @param dontCare - Cubes that form the don't care set of the function.
+		 * @throw <code>std::domain_error</code> - If <code>nVariables</code> is illegal.
+		 */
+		Espresso(unsigned char nVariables, const DNF &dnf, const DNF &dontCare = {});
+
+		/**
+		 * Repeats reduce, expand and irredundant steps while the cost of the cover decreases.
+		 * @return The minimized cover.
+		 */
+		DNF Minimize();
+
+		/**
+		 * @return Whether the union of <code>cubes</code> is a tautology over the variables in <code>variables</code>.
+		 * @param variables - Mask of the variables the cubes depend on.
+		 */
+		static bool IsTautology(const std::vector<Implicant> &cubes, ullong variables);
+
+		/**
+		 * @return The cubes of <code>cubes</code> that intersect <code>cube</code>,
+		 * with all variables of <code>cube</code> removed.
+		 */
+		static std::vector<Implicant> Cofactor(const std::vector<Implicant> &cubes, const Implicant &cube);
+	};
+
+	/**
+	 * Finds a near-minimal disjunctive normal form of a logical function, without expanding it into minterms.
+	 * @param nVariables - Number of variables of the logical function.
+	 * @param dnf - Base disjunctive normal form that constitutes a logical function.
+	 * @param[optional] dontCare - Don't care combinations, given as arbitrary implicants.
+	 * @see <code>Espresso</code>
+	 */
+	DNF MinimizeHeuristic(unsigned char nVariables, const DNF &dnf, const DNF &dontCare = {});
+}
@@ -112,14 +112,7 @@ ullong Implicant::GetMask() const
 
 int Implicant::GetVariableCount() const
 {
-	int count = 0;
-	ullong mask = Implicant::mask;
-	while (mask)
-	{
-		++count;
-		mask &= mask - 1;
-	}
-	return count;
+	return numeric::PopCount(mask);
 }
 
 bool Implicant::operator<(const Implicant &x) const
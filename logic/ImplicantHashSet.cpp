@@ -0,0 +1,85 @@
+#include "ImplicantHashSet.h"
+
+namespace logic
+{
+	ImplicantHashSet::ImplicantHashSet(size_t expectedSize)
+	{
+		size_t capacity = 16;
+		while (capacity < 2 * expectedSize)
+			capacity <<= 1U;
+		Rehash(capacity);
+	}
+
+	ullong ImplicantHashSet::Hash(ullong form, ullong mask)
+	{
+		// Finalizer of MurmurHash3, applied to a combination of both words
+		ullong x = form * 0x9E3779B97F4A7C15ULL ^ mask;
+		x ^= x >> 33U;
+		x *= 0xFF51AFD7ED558CCDULL;
+		x ^= x >> 33U;
+		x *= 0xC4CEB9FE1A85EC53ULL;
+		x ^= x >> 33U;
+		return x;
+	}
+
+	size_t ImplicantHashSet::FindSlot(ullong form, ullong mask) const
+	{
+		// The capacity is a power of 2
+		size_t slotMask = forms.size() - 1, slot = Hash(form, mask) & slotMask;
+		while (occupied[slot] && (forms[slot] != form || masks[slot] != mask))
+			slot = (slot + 1) & slotMask;
+		return slot;
+	}
+
+	void ImplicantHashSet::Rehash(size_t capacity)
+	{
+		std::vector<ullong> oldForms(capacity, 0), oldMasks(capacity, 0);
+		std::vector<bool> oldOccupied(capacity, false);
+		forms.swap(oldForms);
+		masks.swap(oldMasks);
+		occupied.swap(oldOccupied);
+		for (size_t i = 0; i < oldOccupied.size(); ++i)
+			if (oldOccupied[i])
+			{
+				size_t slot = FindSlot(oldForms[i], oldMasks[i]);
+				forms[slot] = oldForms[i];
+				masks[slot] = oldMasks[i];
+				occupied[slot] = true;
+			}
+	}
+
+	bool ImplicantHashSet::Insert(ullong form, ullong mask)
+	{
+		form &= mask;
+		size_t slot = FindSlot(form, mask);
+		if (occupied[slot])
+			return false;
+		forms[slot] = form;
+		masks[slot] = mask;
+		occupied[slot] = true;
+		if (2 * ++size > forms.size())
+			Rehash(2 * forms.size());
+		return true;
+	}
+
+	bool ImplicantHashSet::Contains(ullong form, ullong mask) const
+	{
+		form &= mask;
+		return occupied[FindSlot(form, mask)];
+	}
+
+	size_t ImplicantHashSet::GetSize() const
+	{
+		return size;
+	}
+
+	ImplicantTable ImplicantHashSet::ToTable() const
+	{
+		ImplicantTable table;
+		table.Reserve(size);
+		for (size_t i = 0; i < occupied.size(); ++i)
+			if (occupied[i])
+				table.PushBack(forms[i], masks[i]);
+		return table;
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+
+#include "ImplicantTable.h"
+
+namespace logic
+{
+	/**
+	 * Open addressing hash set of implicants, keyed on the (form, mask) pair.
+	 * Used to deduplicate implicants within an iteration of McCluskey, where
+	 * the same implicant is usually produced by several pairs of implicants.
+	 * Collisions are resolved by linear probing, the table is kept at most half full.
+	 */
+	class ImplicantHashSet
+	{
+		std::vector<ullong> forms, masks;
+		std::vector<bool> occupied;
+		size_t size = 0;
+
+		/**
+		 * @return Index of the slot that holds the implicant, or of the empty slot where it belongs.
+		 */
+		size_t FindSlot(ullong form, ullong mask) const;
+
+		void Rehash(size_t capacity);
+
+	public:
+		/**
+		 * @param expectedSize - Number of implicants the set should hold without rehashing.
+		 */
+		explicit ImplicantHashSet(size_t expectedSize = 0);
+
+		/**
+		 * Mixes the form and mask of an implicant into a 64-bit hash.
+		 */
+		static ullong Hash(ullong form, ullong mask);
+
+		/**
+		 * @return Whether the implicant was inserted, i.e. it wasn't already contained in the set.
+		 */
+		bool Insert(ullong form, ullong mask);
+
+		bool Contains(ullong form, ullong mask) const;
+
+		size_t GetSize() const;
+
+		/**
+		 * @return Table of all implicants in the set, in unspecified order.
+		 */
+		ImplicantTable ToTable() const;
+	};
+}
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+#include "ImplicantTable.h"
+
+namespace logic
+{
+	ImplicantTable::ImplicantTable(const DNF &dnf)
+	{
+		Reserve(dnf.size());
+		for (auto &implicant : dnf)
+			PushBack(implicant);
+	}
+
+	void ImplicantTable::Append(const ImplicantTable &table)
+	{
+		forms.insert(forms.end(), table.forms.begin(), table.forms.end());
+		masks.insert(masks.end(), table.masks.begin(), table.masks.end());
+	}
+
+	void ImplicantTable::Reserve(size_t size)
+	{
+		forms.reserve(size);
+		masks.reserve(size);
+	}
+
+	void ImplicantTable::Clear()
+	{
+		forms.clear();
+		masks.clear();
+	}
+
+	void ImplicantTable::Sort()
+	{
+		std::vector<size_t> order(GetSize());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [this](size_t x, size_t y) {
+			return masks[x] > masks[y] || (masks[x] == masks[y] && forms[x] < forms[y]);
+		});
+		std::vector<ullong> sortedForms(GetSize()), sortedMasks(GetSize());
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			sortedForms[i] = forms[order[i]];
+			sortedMasks[i] = masks[order[i]];
+		}
+		forms = std::move(sortedForms);
+		masks = std::move(sortedMasks);
+	}
+
+	void ImplicantTable::SortAndDeduplicate()
+	{
+		Sort();
+		size_t size = 0;
+		for (size_t i = 0; i < GetSize(); ++i)
+			if (size == 0 || forms[i] != forms[size - 1] || masks[i] != masks[size - 1])
+			{
+				forms[size] = forms[i];
+				masks[size] = masks[i];
+				++size;
+			}
+		forms.resize(size);
+		masks.resize(size);
+	}
+
+	void ImplicantTable::PartitionByMask()
+	{
+		// Groups are numbered in order of appearance, then the implicants are scattered into place
+		std::unordered_map<ullong, size_t> groupIndex;
+		std::vector<size_t> group(GetSize()), groupBegin;
+		for (size_t i = 0; i < GetSize(); ++i)
+		{
+			auto it = groupIndex.emplace(masks[i], groupBegin.size()).first;
+			if (it->second == groupBegin.size())
+				groupBegin.push_back(0);
+			group[i] = it->second;
+			++groupBegin[group[i]];
+		}
+		for (size_t g = 0, begin = 0; g < groupBegin.size(); ++g)
+		{
+			size_t groupSize = groupBegin[g];
+			groupBegin[g] = begin;
+			begin += groupSize;
+		}
+		std::vector<ullong> partitionedForms(GetSize()), partitionedMasks(GetSize());
+		for (size_t i = 0; i < GetSize(); ++i)
+		{
+			size_t position = groupBegin[group[i]]++;
+			partitionedForms[position] = forms[i];
+			partitionedMasks[position] = masks[i];
+		}
+		forms = std::move(partitionedForms);
+		masks = std::move(partitionedMasks);
+	}
+
+	ImplicantTable::View ImplicantTable::GetView(size_t begin, size_t end) const
+	{
+		return {forms.data() + begin, masks.data() + begin, end - begin};
+	}
+
+	ImplicantTable::View ImplicantTable::GetView() const
+	{
+		return GetView(0, GetSize());
+	}
+
+	std::vector<ImplicantTable::View> ImplicantTable::GroupByMask() const
+	{
+		std::vector<View> groups;
+		for (size_t begin = 0, end; begin < GetSize(); begin = end)
+		{
+			for (end = begin + 1; end < GetSize() && masks[end] == masks[begin]; ++end);
+			groups.push_back(GetView(begin, end));
+		}
+		return groups;
+	}
+
+	DNF ImplicantTable::ToDNF() const
+	{
+		DNF dnf;
+		for (size_t i = 0; i < GetSize(); ++i)
+			dnf.emplace_hint(dnf.end(), forms[i], masks[i]);
+		return dnf;
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vector>
+
+#include "Implicant.h"
+#include "symbols.h"
+
+namespace logic
+{
+	/**
+	 * Container of implicants stored as a structure of arrays: forms and masks are kept
+	 * in two contiguous arrays, so hot loops can scan them without chasing tree nodes.
+	 * The same invariant as in <code>Implicant</code> holds: form bits are 0 wherever mask bits are 0.
+	 */
+	class ImplicantTable
+	{
+		std::vector<ullong> forms, masks;
+
+	public:
+		/**
+		 * Read-only view of a contiguous range of a table.
+		 */
+		struct View
+		{
+			const ullong *forms, *masks;
+			size_t size;
+
+			Implicant operator[](size_t i) const
+			{ return {forms[i], masks[i]}; }
+		};
+
+		ImplicantTable() = default;
+
+		explicit ImplicantTable(const DNF &dnf);
+
+		// Modifiers
+
+		void PushBack(ullong form, ullong mask)
+		{
+			forms.push_back(form & mask);
+			masks.push_back(mask);
+		}
+
+		void PushBack(const Implicant &implicant)
+		{
+			PushBack(implicant.GetForm(), implicant.GetMask());
+		}
+
+		void Append(const ImplicantTable &table);
+
+		void Reserve(size_t size);
+
+		void Clear();
+
+		/**
+		 * Sorts the implicants in the same order as in a <code>DNF</code>
+		 * (descending masks, ascending forms for equal masks).
+		 */
+		void Sort();
+
+		/**
+		 * Sorts the implicants and removes duplicates.
+		 */
+		void SortAndDeduplicate();
+
+		/**
+		 * Reorders the implicants so that those with equal masks are contiguous.
+		 * Unlike <code>Sort()</code>, this takes linear time. The order of the groups and
+		 * the order within a group are unspecified.
+		 */
+		void PartitionByMask();
+
+		// Getters
+
+		size_t GetSize() const
+		{ return forms.size(); }
+
+		bool IsEmpty() const
+		{ return forms.empty(); }
+
+		ullong GetForm(size_t i) const
+		{ return forms[i]; }
+
+		ullong GetMask(size_t i) const
+		{ return masks[i]; }
+
+		Implicant operator[](size_t i) const
+		{ return {forms[i], masks[i]}; }
+
+		const std::vector<ullong> &GetForms() const
+		{ return forms; }
+
+		const std::vector<ullong> &GetMasks() const
+		{ return masks; }
+
+		/** @return View of the implicants in the range [begin, end). */
+		View GetView(size_t begin, size_t end) const;
+
+		/** @return View of the whole table. */
+		View GetView() const;
+
+		/**
+		 * @return Views of maximal ranges of implicants that share the same mask.
+		 * @note The table should be sorted or partitioned by mask, otherwise equal masks need not be contiguous.
+		 */
+		std::vector<View> GroupByMask() const;
+
+		DNF ToDNF() const;
+	};
+}
@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <thread>
+
+#include "IncrementalMinimizer.h"
+#include "CoverTable.h"
+#include "McCluskey.h"
+#include "../numeric/NumericGeneral.h"
+
+namespace logic
+{
+	IncrementalMinimizer::IncrementalMinimizer(const TruthTable &table) : table(table)
+	{
+		FindAllPrimeImplicants();
+	}
+
+	void IncrementalMinimizer::FindAllPrimeImplicants()
+	{
+		ImplicantTable primes;
+		logic::GetPrimeImplicants(table, primes, std::thread::hardware_concurrency());
+		primeImplicants.clear();
+		for (size_t i = 0; i < primes.GetSize(); ++i)
+			primeImplicants.emplace_hint(primeImplicants.end(), primes[i], GetRequiredMinterms(primes[i]));
+	}
+
+	bool IncrementalMinimizer::IsCare(ullong minterm) const
+	{
+		return table.IsOn(minterm) || table.IsDontCare(minterm);
+	}
+
+	bool IncrementalMinimizer::IsRequired(ullong minterm) const
+	{
+		return table.IsOn(minterm) && !table.IsDontCare(minterm);
+	}
+
+	bool IncrementalMinimizer::IsImplicant(ullong form, ullong mask) const
+	{
+		return table.ForEachWord(Implicant(form, mask), [this](ullong i, ullong pattern) {
+			return (table.CareWord(i) & pattern) == pattern;
+		});
+	}
+
+	std::vector<ullong> IncrementalMinimizer::GetRequiredMinterms(const Implicant &implicant) const
+	{
+		std::vector<ullong> minterms;
+		table.ForEachWord(implicant, [this, &minterms](ullong i, ullong pattern) {
+			for (ullong word = table.RequiredWord(i) & pattern; word; word &= word - 1)
+				minterms.push_back((i << TruthTable::WORD_BITS) | numeric::CountTrailingZeros(word));
+			return true;
+		});
+		return minterms;
+	}
+
+	bool IncrementalMinimizer::FindPrimeImplicants(ullong form, ullong mask, unsigned char start, DNF &primes,
+												   size_t &budget) const
+	{
+		if (budget-- == 0)
+			return false;
+		bool isPrime = true;
+		for (unsigned char i = 0; i < table.GetVariableCount(); ++i)
+		{
+			ullong sampler = 1ULL << i;
+			// The cube can lose variable i if its other half along the variable is an implicant as well
+			if ((mask & sampler) == 0 || !IsImplicant(form ^ sampler, mask))
+				continue;
+			isPrime = false;
+			if (i >= start && !FindPrimeImplicants(form & ~sampler, mask & ~sampler, i + 1, primes, budget))
+				return false;
+		}
+		if (isPrime)
+			primes.emplace(form, mask);
+		return true;
+	}
+
+	void IncrementalMinimizer::Grow(ullong minterm)
+	{
+		// Every implicant that wasn't there before contains the minterm, so every new prime implicant does too.
+		// In a dense function, the minterm may be contained in so many implicants that visiting them all costs more
+		// than finding all prime implicants from scratch, so the search gives up after about as many steps
+		constexpr size_t MIN_GROW_BUDGET = 1024;
+		DNF newPrimes;
+		size_t budget = std::max<size_t>(table.GetWordCount(), MIN_GROW_BUDGET);
+		if (!FindPrimeImplicants(minterm, table.GetSize() - 1, 0, newPrimes, budget))
+			return FindAllPrimeImplicants();
+		for (auto it = primeImplicants.begin(); it != primeImplicants.end();)
+			if (std::any_of(newPrimes.begin(), newPrimes.end(), [&it](const Implicant &prime) {
+				return prime.ImpliedBy(it->first);
+			}))
+				it = primeImplicants.erase(it);
+			else
+				++it;
+		for (auto &prime : newPrimes)
+			primeImplicants.emplace(prime, GetRequiredMinterms(prime));
+	}
+
+	void IncrementalMinimizer::Shrink(ullong minterm)
+	{
+		// An implicant of the new function is contained in a prime implicant of the old one. If that prime implicant
+		// contains the minterm, the implicant is contained in one of its halves that don't.
+		DNF halves;
+		for (auto it = primeImplicants.begin(); it != primeImplicants.end();)
+		{
+			ullong form = it->first.GetForm(), mask = it->first.GetMask();
+			if ((minterm & mask) != form)
+			{
+				++it;
+				continue;
+			}
+			for (ullong free = ~mask & (table.GetSize() - 1); free; free &= free - 1)
+			{
+				ullong sampler = free & -free;
+				halves.emplace(form | (~minterm & sampler), mask | sampler);
+			}
+			it = primeImplicants.erase(it);
+		}
+		// The remaining prime implicants are still prime, and none of them is contained in a half
+		for (auto &half : halves)
+		{
+			auto contains = [&half](const Implicant &implicant) {
+				return implicant.ImpliedBy(half) && implicant.GetMask() != half.GetMask();
+			};
+			if (std::none_of(halves.begin(), halves.end(), contains) &&
+				std::none_of(primeImplicants.begin(), primeImplicants.end(), [&contains](auto &prime) {
+					return contains(prime.first);
+				}))
+				primeImplicants.emplace(half, GetRequiredMinterms(half));
+		}
+	}
+
+	void IncrementalMinimizer::Set(ullong minterm, bool isOn, bool isDontCare)
+	{
+		bool wasCare = IsCare(minterm), wasRequired = IsRequired(minterm);
+		table.SetOn(minterm, isOn);
+		table.SetDontCare(minterm, isDontCare);
+		bool isCare = IsCare(minterm), isRequired = IsRequired(minterm);
+		if (isCare == wasCare && isRequired == wasRequired)
+			return;
+		mdnfs.reset();
+		if (isCare && !wasCare)
+			Grow(minterm);
+		else if (!isCare && wasCare)
+			Shrink(minterm);
+		else
+			// Only the column of the minterm is added to or removed from the rows that contain it
+			for (auto &prime : primeImplicants)
+			{
+				if ((minterm & prime.first.GetMask()) != prime.first.GetForm())
+					continue;
+				auto &minterms = prime.second;
+				auto it = std::lower_bound(minterms.begin(), minterms.end(), minterm);
+				if (isRequired)
+					minterms.insert(it, minterm);
+				else
+					minterms.erase(it);
+			}
+	}
+
+	void IncrementalMinimizer::AddMinterm(ullong minterm)
+	{
+		Set(minterm, true, false);
+	}
+
+	void IncrementalMinimizer::RemoveMinterm(ullong minterm)
+	{
+		Set(minterm, false, false);
+	}
+
+	void IncrementalMinimizer::SetDontCare(ullong minterm, bool value)
+	{
+		if (value)
+			Set(minterm, false, true);
+		else if (table.IsDontCare(minterm))
+			Set(minterm, false, false);
+	}
+
+	const TruthTable &IncrementalMinimizer::GetTable() const
+	{
+		return table;
+	}
+
+	DNF IncrementalMinimizer::GetPrimeImplicants() const
+	{
+		DNF primes;
+		for (auto &prime : primeImplicants)
+			primes.insert(primes.end(), prime.first);
+		return primes;
+	}
+
+	const MDNFSet &IncrementalMinimizer::GetMDNFSet()
+	{
+		if (mdnfs)
+			return *mdnfs;
+		// Columns are the minterms that have to be covered, in ascending order
+		std::vector<ullong> minterms;
+		table.ForEachRequired([&minterms](ullong minterm) {
+			minterms.push_back(minterm);
+		});
+		ImplicantTable primes;
+		primes.Reserve(primeImplicants.size());
+		std::vector<int> rowCost;
+		std::vector<std::vector<size_t>> rowColumns;
+		for (auto &prime : primeImplicants)
+		{
+			primes.PushBack(prime.first);
+			rowCost.push_back(numeric::PopCount(prime.first.GetMask()));
+			std::vector<size_t> columns;
+			for (auto minterm : prime.second)
+				columns.push_back(std::lower_bound(minterms.begin(), minterms.end(), minterm) - minterms.begin());
+			rowColumns.push_back(std::move(columns));
+		}
+		mdnfs = GetMinimalCovers(primes, CoverTable(std::move(rowCost), std::move(rowColumns), minterms.size()));
+		return *mdnfs;
+	}
+
+	std::set<DNF> IncrementalMinimizer::GetMDNF()
+	{
+		return GetMDNFSet().ToSet();
+	}
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+#include "Implicant.h"
+#include "MDNFSet.h"
+#include "TruthTable.h"
+
+namespace logic
+{
+	/**
+	 * Minimizer of a function that changes a few minterms at a time. The prime implicants and the rows
+	 * of the prime implicant chart are kept between minimizations and only those affected by a change are updated:
+	 * <ul>
+	 * <li>When a minterm joins the ON or don't care set, the new prime implicants are the maximal implicants
+	 * that contain it, and the old prime implicants they contain are dropped.</li>
+	 * <li>When a minterm leaves both sets, the prime implicants that contain it are dropped. They are replaced by
+	 * their halves that don't contain the minterm, unless such a half is contained in another prime implicant
+	 * or another half.</li>
+	 * <li>When a minterm switches between the ON and don't care sets, the prime implicants stay the same and only
+	 * the rows of those that contain it gain or lose its column.</li>
+	 * </ul>
+	 * The cover search itself is repeated on the next call to <code>GetMDNFSet()</code> after a change.
+	 */
+	class IncrementalMinimizer
+	{
+		TruthTable table;
+		// Each prime implicant, along with the minterms it covers that have to be covered, in ascending order
+		std::map<Implicant, std::vector<ullong>> primeImplicants;
+		// Result of the last minimization, reset by every change
+		std::optional<MDNFSet> mdnfs;
+
+		bool IsCare(ullong minterm) const;
+
+		bool IsRequired(ullong minterm) const;
+
+		/** @return Whether all minterms of the cube given by <code>form</code> and <code>mask</code> are ON or don't care. */
+		bool IsImplicant(ullong form, ullong mask) const;
+
+		/** @return The minterms of <code>implicant</code> that have to be covered, in ascending order. */
+		std::vector<ullong> GetRequiredMinterms(const Implicant &implicant) const;
+
+		/** Replaces the prime implicants with those found from scratch. */
+		void FindAllPrimeImplicants();
+
+		/**
+		 * Inserts into <code>primes</code> the prime implicants that contain the given cube, which must be an implicant.
+		 * Only variables starting at <code>start</code> are removed from the cube, so each implicant is visited once.
+		 * @param budget - Number of implicants that may still be visited, decreased by each visit.
+		 * @return <code>false</code> if the budget has run out, in which case <code>primes</code> is incomplete.
+		 */
+		bool FindPrimeImplicants(ullong form, ullong mask, unsigned char start, DNF &primes, size_t &budget) const;
+
+		/**
+		 * Updates the prime implicants after <code>minterm</code> has joined the ON or don't care set.
+		 * If the minterm is contained in too many implicants, all prime implicants are found from scratch instead.
+		 */
+		void Grow(ullong minterm);
+
+		/** Updates the prime implicants after <code>minterm</code> has left both the ON and don't care set. */
+		void Shrink(ullong minterm);
+
+		/** Sets the state of <code>minterm</code> and updates everything that depends on it. */
+		void Set(ullong minterm, bool isOn, bool isDontCare);
+
+	public:
+		/** Finds the prime implicants of <code>table</code> from scratch. */
+		explicit IncrementalMinimizer(const TruthTable &table);
+
+		// Modifiers
+
+		/** Adds <code>minterm</code> to the ON set. If it was don't care, it has to be covered from now on. */
+		void AddMinterm(ullong minterm);
+
+		/** Removes <code>minterm</code> from both the ON and don't care set. */
+		void RemoveMinterm(ullong minterm);
+
+		/**
+		 * Makes <code>minterm</code> don't care if <code>value</code> is <code>true</code>. Otherwise, a don't care
+		 * <code>minterm</code> is removed from the function and any other minterm stays as it is.
+		 */
+		void SetDontCare(ullong minterm, bool value = true);
+
+		// Getters
+
+		const TruthTable &GetTable() const;
+
+		DNF GetPrimeImplicants() const;
+
+		/**
+		 * @return Minimal disjunctive normal forms of the current function, which are the same as those
+		 * returned by <code>ComputeMDNFSet()</code>.
+		 */
+		const MDNFSet &GetMDNFSet();
+
+		/** @see <code>GetMDNFSet()</code> */
+		std::set<DNF> GetMDNF();
+	};
+}
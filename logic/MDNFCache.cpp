@@ -0,0 +1,256 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include "MDNFCache.h"
+#include "MappedFile.h"
+#include "McCluskey.h"
+#include "MDNFDatabase.h"
+#include "NPN.h"
+#include "ImplicantHashSet.h"
+
+namespace logic
+{
+	// Files of the on-disk tier start with this magic number (the version is its last byte)
+	static constexpr ullong FILE_MAGIC = 0x464E444D00000002ULL;
+
+	MDNFCache::MDNFCache(size_t capacity, std::string directory) : capacity(capacity), directory(std::move(directory))
+	{}
+
+	void MDNFCache::SetDirectory(const std::string &directory)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		MDNFCache::directory = directory;
+	}
+
+	MDNFCache::Key MDNFCache::GetKey(const TruthTable &table)
+	{
+		// Both hashes are seeded differently and absorb the same words
+		Key key{0x243F6A8885A308D3ULL, 0x13198A2E03707344ULL};
+		auto absorb = [&key](ullong word) {
+			key.first = ImplicantHashSet::Hash(key.first, word);
+			key.second = ImplicantHashSet::Hash(word, key.second);
+		};
+		absorb(table.GetVariableCount());
+		for (ullong i = 0; i < table.GetWordCount(); ++i)
+		{
+			absorb(table.RequiredWord(i));
+			absorb(table.DontCareWord(i));
+		}
+		return key;
+	}
+
+	std::string MDNFCache::GetPath(const std::string &directory, const Key &key)
+	{
+		char name[40];
+		std::snprintf(name, sizeof name, "%016llx%016llx.mdnf", key.first, key.second);
+		return (std::filesystem::path(directory) / name).string();
+	}
+
+	bool MDNFCache::Load(const std::string &directory, const Key &key, MDNFSet &mdnfs)
+	{
+		MappedFile file(GetPath(directory, key));
+		if (!file.IsOpen())
+			return false;
+		// The file is a sequence of words: magic, key, number of shared implicants, number of essential implicants,
+		// the forms and masks of the shared implicants, number of MDNFs, then the number of implicants selected
+		// by each MDNF followed by their indices
+		size_t nWords = file.GetSize() / sizeof(ullong), position = 0;
+		auto read = [&](ullong &word) {
+			if (position == nWords)
+				return false;
+			std::memcpy(&word, file.GetData() + position++ * sizeof(ullong), sizeof(ullong));
+			return true;
+		};
+		ullong magic, first, second, nImplicants, nEssential, nForms;
+		if (!read(magic) || magic != FILE_MAGIC || !read(first) || !read(second) || Key(first, second) != key ||
+			!read(nImplicants) || !read(nEssential) || nEssential > nImplicants || nImplicants > nWords)
+			return false;
+		ImplicantTable implicants;
+		implicants.Reserve(nImplicants);
+		for (ullong i = 0; i < nImplicants; ++i)
+		{
+			ullong form, mask;
+			if (!read(form) || !read(mask))
+				return false;
+			implicants.PushBack(form, mask);
+		}
+		if (!read(nForms))
+			return false;
+		MDNFSet result(std::move(implicants), nEssential);
+		std::vector<uint32_t> indices;
+		for (ullong i = 0; i < nForms; ++i)
+		{
+			ullong nSelected, index;
+			if (!read(nSelected))
+				return false;
+			indices.clear();
+			for (ullong j = 0; j < nSelected; ++j)
+			{
+				if (!read(index) || index >= nImplicants - nEssential)
+					return false;
+				indices.push_back(index);
+			}
+			result.Add(indices.begin(), indices.end());
+		}
+		mdnfs = std::move(result);
+		return true;
+	}
+
+	void MDNFCache::Store(const std::string &directory, const Key &key, const MDNFSet &mdnfs)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+		const ImplicantTable &implicants = mdnfs.GetImplicants();
+		std::vector<ullong> words{FILE_MAGIC, key.first, key.second, implicants.GetSize(), mdnfs.GetEssentialCount()};
+		for (size_t i = 0; i < implicants.GetSize(); ++i)
+		{
+			words.push_back(implicants.GetForm(i));
+			words.push_back(implicants.GetMask(i));
+		}
+		words.push_back(mdnfs.GetSize());
+		for (size_t i = 0; i < mdnfs.GetSize(); ++i)
+		{
+			words.push_back(mdnfs.GetImplicantCount(i) - mdnfs.GetEssentialCount());
+			mdnfs.ForEachSelected(i, [&words](uint32_t index) {
+				words.push_back(index);
+			});
+		}
+		// Readers never see a partially written file, since it only gets its name once it is complete
+		std::string path = GetPath(directory, key), temporaryPath = path + '.' + std::to_string(std::random_device()()) + ".tmp";
+		{
+			std::ofstream stream(temporaryPath, std::ios::binary);
+			stream.write(reinterpret_cast<const char *>(words.data()), words.size() * sizeof(ullong));
+			if (!stream)
+			{
+				stream.close();
+				std::filesystem::remove(temporaryPath, error);
+				return;
+			}
+		}
+		std::filesystem::rename(temporaryPath, path, error);
+		if (error)
+			std::filesystem::remove(temporaryPath, error);
+	}
+
+	void MDNFCache::Remember(const Key &key, const MDNFSet &mdnfs)
+	{
+		if (capacity == 0)
+			return;
+		auto it = index.find(key);
+		if (it != index.end())
+		{
+			entries.erase(it->second);
+			index.erase(it);
+		}
+		else if (entries.size() == capacity)
+		{
+			index.erase(entries.back().first);
+			entries.pop_back();
+		}
+		entries.emplace_front(key, mdnfs);
+		index[key] = entries.begin();
+	}
+
+	bool MDNFCache::Find(const TruthTable &table, MDNFSet &mdnfs)
+	{
+		return Find(GetKey(table), mdnfs, true);
+	}
+
+	bool MDNFCache::Find(const Key &key, MDNFSet &mdnfs, bool countMiss)
+	{
+		std::string directory;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto it = index.find(key);
+			if (it != index.end())
+			{
+				++statistics.memoryHits;
+				entries.splice(entries.begin(), entries, it->second);
+				mdnfs = it->second->second;
+				return true;
+			}
+			directory = MDNFCache::directory;
+		}
+		// Files are read without the lock, so that lookups of other threads don't wait for the disk
+		bool isLoaded = !directory.empty() && Load(directory, key, mdnfs);
+		std::lock_guard<std::mutex> lock(mutex);
+		if (isLoaded)
+		{
+			++statistics.diskHits;
+			Remember(key, mdnfs);
+		}
+		else if (countMiss)
+			++statistics.misses;
+		return isLoaded;
+	}
+
+	void MDNFCache::Insert(const TruthTable &table, const MDNFSet &mdnfs)
+	{
+		Key key = GetKey(table);
+		std::string directory;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			Remember(key, mdnfs);
+			directory = MDNFCache::directory;
+		}
+		if (!directory.empty())
+			Store(directory, key, mdnfs);
+	}
+
+	/** @return Whether the function has no minterm that must be covered, or no minterm that must not be. */
+	static bool _IsConstant(const TruthTable &table)
+	{
+		ullong wordMask = table.GetVariableCount() < TruthTable::WORD_BITS ? full_mask(table.GetSize()) : ~0ULL;
+		bool isZero = true, isOne = true;
+		for (ullong i = 0; i < table.GetWordCount() && (isZero || isOne); ++i)
+		{
+			isZero &= table.RequiredWord(i) == 0;
+			isOne &= table.CareWord(i) == wordMask;
+		}
+		return isZero || isOne;
+	}
+
+	MDNFSet MDNFCache::GetMDNFSet(const TruthTable &table, unsigned nThreads)
+	{
+		// Reading the database is cheaper than any cache lookup
+		std::set<DNF> forms;
+		if (MDNFDatabase::GetDefault().Find(table, forms))
+			return MDNFSet(forms);
+		Key key = GetKey(table);
+		bool useNPN = table.GetVariableCount() <= MAX_NPN_VARIABLES && !_IsConstant(table);
+		MDNFSet mdnfs;
+		if (Find(key, mdnfs, !useNPN))
+			return mdnfs;
+		if (!useNPN)
+		{
+			mdnfs = logic::GetMDNFSet(table, nThreads);
+			Insert(table, mdnfs);
+			return mdnfs;
+		}
+		NPNTransform transform;
+		TruthTable canonical = GetNPNCanonicalForm(table, transform, false);
+		if (!Find(canonical, mdnfs))
+		{
+			mdnfs = logic::GetMDNFSet(canonical, nThreads);
+			Insert(canonical, mdnfs);
+		}
+		mdnfs = transform.ToOriginal(mdnfs);
+		// The function itself is only remembered in memory, the directory keeps a single file per class
+		std::lock_guard<std::mutex> lock(mutex);
+		Remember(key, mdnfs);
+		return mdnfs;
+	}
+
+	std::set<DNF> MDNFCache::GetMDNF(const TruthTable &table, unsigned nThreads)
+	{
+		return GetMDNFSet(table, nThreads).ToSet();
+	}
+
+	const MDNFCache::Statistics &MDNFCache::GetStatistics() const
+	{
+		return statistics;
+	}
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "Implicant.h"
+#include "MDNFSet.h"
+#include "TruthTable.h"
+
+namespace logic
+{
+	/**
+	 * Memoization of minimal disjunctive normal forms. A function is identified by a 128-bit hash of its
+	 * variable count, the minterms that must be covered and the don't care minterms, so equal functions share
+	 * an entry no matter how they were specified. Results are kept in an in-memory LRU tier of limited capacity
+	 * and, optionally, in a directory with one file per function. Files are memory mapped when they are read
+	 * and replaced atomically when they are written, so the directory can be shared between processes.
+	 * Both tiers keep the MDNFs of a function as an <code>MDNFSet</code>, whose forms share their implicants.
+	 * The cache may be used by several threads at once.
+	 */
+	class MDNFCache
+	{
+	public:
+		/** Key of a function, made of two independent 64-bit hashes. */
+		using Key = std::pair<ullong, ullong>;
+
+		struct Statistics
+		{
+			ullong memoryHits = 0, diskHits = 0, misses = 0;
+		};
+
+		/** Functions of up to this many variables are stored on disk by their NPN canonical form. */
+		static constexpr unsigned char MAX_NPN_VARIABLES = 10;
+
+	private:
+		struct KeyHash
+		{
+			size_t operator()(const Key &key) const
+			{ return key.first; }
+		};
+
+		size_t capacity;
+		std::string directory;
+		// Most recently used entries come first
+		std::list<std::pair<Key, MDNFSet>> entries;
+		std::unordered_map<Key, std::list<std::pair<Key, MDNFSet>>::iterator, KeyHash> index;
+		Statistics statistics;
+		// Guards the entries, the statistics and the directory, but neither the files nor the minimization on a miss
+		std::mutex mutex;
+
+		/** @return Path of the file of the given key in <code>directory</code>. */
+		static std::string GetPath(const std::string &directory, const Key &key);
+
+		/** Reads the entry of the given key from <code>directory</code>. */
+		static bool Load(const std::string &directory, const Key &key, MDNFSet &mdnfs);
+
+		/** Writes the entry of the given key to <code>directory</code>. Failures are ignored. */
+		static void Store(const std::string &directory, const Key &key, const MDNFSet &mdnfs);
+
+		/**
+		 * Looks up the memory tier first and the disk tier second. Hits are counted, and so is a miss
+		 * if <code>countMiss</code> is set.
+		 */
+		bool Find(const Key &key, MDNFSet &mdnfs, bool countMiss);
+
+		/**
+		 * Puts the entry at the front of the in-memory tier, evicting the least recently used one if it is full.
+		 * The mutex must be held.
+		 */
+		void Remember(const Key &key, const MDNFSet &mdnfs);
+
+	public:
+		/**
+		 * @param capacity - Maximum number of entries of the in-memory tier.
+		 * @param directory - Directory of the on-disk tier, which is not used if empty.
+		 */
+		explicit MDNFCache(size_t capacity = 256, std::string directory = "");
+
+		/** Sets the directory of the on-disk tier. It is created on the first write. */
+		void SetDirectory(const std::string &directory);
+
+		/** @return The key under which the function given by <code>table</code> is cached. */
+		static Key GetKey(const TruthTable &table);
+
+		/**
+		 * Looks up the memory tier first and the disk tier second. Hits and misses are counted.
+		 * @return Whether the function was found, in which case <code>mdnfs</code> contains its MDNFs.
+		 */
+		bool Find(const TruthTable &table, MDNFSet &mdnfs);
+
+		/** Stores the MDNFs of a function in both tiers. */
+		void Insert(const TruthTable &table, const MDNFSet &mdnfs);
+
+		/**
+		 * The function is looked up by its own key first. If it is missing, functions of up to
+		 * <code>MAX_NPN_VARIABLES</code> variables are then brought to their NP canonical form (without output
+		 * complement, which doesn't preserve MDNFs), so functions that only differ by a permutation or negation
+		 * of the inputs share an entry in both tiers. Only the canonical function is minimized and its MDNFs are
+		 * mapped back through the transform. Constant functions are minimized directly, since that is cheaper
+		 * than finding their canonical form.
+		 * Functions found in <code>MDNFDatabase::GetDefault()</code> bypass the cache.
+		 * @param nThreads - Number of threads used on a miss, 0 meaning all hardware threads.
+		 * @return Cached MDNFs of the function, which are found by <code>logic::GetMDNFSet</code> and cached on a miss.
+		 */
+		MDNFSet GetMDNFSet(const TruthTable &table, unsigned nThreads = 0);
+
+		/** @see <code>GetMDNFSet()</code> */
+		std::set<DNF> GetMDNF(const TruthTable &table, unsigned nThreads = 0);
+
+		const Statistics &GetStatistics() const;
+	};
+}
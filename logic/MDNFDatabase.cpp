@@ -0,0 +1,121 @@
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "MDNFDatabase.h"
+#include "McCluskey.h"
+
+namespace logic
+{
+	// The database starts with this magic number (the version is its last byte), followed by the offsets
+	static constexpr ullong DATABASE_MAGIC = 0x4244464E444D0001ULL;
+	static constexpr size_t OFFSETS_POSITION = sizeof(ullong);
+	static constexpr size_t ENTRIES_POSITION = OFFSETS_POSITION + (MDNFDatabase::FUNCTION_COUNT + 1) * sizeof(uint32_t);
+
+	MDNFDatabase::MDNFDatabase(const std::string &path) : file(path)
+	{
+		if (!file.IsOpen() || file.GetSize() < ENTRIES_POSITION)
+			return;
+		ullong magic;
+		std::memcpy(&magic, file.GetData(), sizeof magic);
+		isValid = magic == DATABASE_MAGIC && GetOffset(0) == 0 &&
+				  ENTRIES_POSITION + GetOffset(FUNCTION_COUNT) == file.GetSize();
+	}
+
+	const MDNFDatabase &MDNFDatabase::GetDefault()
+	{
+#ifdef MDNF_DATABASE_PATH
+		static const MDNFDatabase database(MDNF_DATABASE_PATH);
+#else
+		static const MDNFDatabase database("");
+#endif
+		return database;
+	}
+
+	size_t MDNFDatabase::GetOffset(size_t i) const
+	{
+		uint32_t offset;
+		std::memcpy(&offset, file.GetData() + OFFSETS_POSITION + i * sizeof offset, sizeof offset);
+		return offset;
+	}
+
+	bool MDNFDatabase::GetIndex(const TruthTable &table, size_t &index)
+	{
+		if (table.GetVariableCount() > MAX_VARIABLES || table.DontCareWord(0) != 0)
+			return false;
+		// The truth table is repeated for each combination of the variables it doesn't have
+		ullong size = table.GetSize();
+		index = table.OnWord(0) & ((1ULL << size) - 1);
+		for (; size < (1U << MAX_VARIABLES); size *= 2)
+			index |= index << size;
+		return true;
+	}
+
+	bool MDNFDatabase::Find(const TruthTable &table, std::set<DNF> &mdnfs) const
+	{
+		size_t index;
+		if (!isValid || !GetIndex(table, index))
+			return false;
+		const unsigned char *entry = file.GetData() + ENTRIES_POSITION + GetOffset(index);
+		uint16_t nForms;
+		std::memcpy(&nForms, entry, sizeof nForms);
+		entry += sizeof nForms;
+		mdnfs.clear();
+		for (uint16_t i = 0; i < nForms; ++i)
+		{
+			DNF dnf;
+			for (unsigned char j = 0, nImplicants = *entry++; j < nImplicants; ++j, ++entry)
+				dnf.emplace_hint(dnf.end(), ullong(*entry >> MAX_VARIABLES), ullong(*entry & ((1U << MAX_VARIABLES) - 1)));
+			mdnfs.insert(mdnfs.end(), std::move(dnf));
+		}
+		return true;
+	}
+
+	bool MDNFDatabase::Generate(const std::string &path)
+	{
+		std::vector<unsigned char> bytes(ENTRIES_POSITION);
+		std::memcpy(bytes.data(), &DATABASE_MAGIC, sizeof DATABASE_MAGIC);
+		for (size_t index = 0; index < FUNCTION_COUNT; ++index)
+		{
+			auto offset = static_cast<uint32_t>(bytes.size() - ENTRIES_POSITION);
+			std::memcpy(bytes.data() + OFFSETS_POSITION + index * sizeof offset, &offset, sizeof offset);
+			TruthTable table(MAX_VARIABLES);
+			for (ullong minterm = 0; minterm < (1U << MAX_VARIABLES); ++minterm)
+				table.SetOn(minterm, index >> minterm & 1);
+			// The database itself must not be used to compute its entries
+			auto mdnfs = ComputeMDNF(table);
+			auto nForms = static_cast<uint16_t>(mdnfs.size());
+			bytes.resize(bytes.size() + sizeof nForms);
+			std::memcpy(bytes.data() + bytes.size() - sizeof nForms, &nForms, sizeof nForms);
+			for (auto &dnf : mdnfs)
+			{
+				bytes.push_back(dnf.size());
+				for (auto &implicant : dnf)
+					bytes.push_back(implicant.GetForm() << MAX_VARIABLES | implicant.GetMask());
+			}
+		}
+		auto end = static_cast<uint32_t>(bytes.size() - ENTRIES_POSITION);
+		std::memcpy(bytes.data() + OFFSETS_POSITION + FUNCTION_COUNT * sizeof end, &end, sizeof end);
+
+		std::error_code error;
+		std::string temporaryPath = path + '.' + std::to_string(std::random_device()()) + ".tmp";
+		{
+			std::ofstream stream(temporaryPath, std::ios::binary);
+			stream.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+			if (!stream)
+			{
+				stream.close();
+				std::filesystem::remove(temporaryPath, error);
+				return false;
+			}
+		}
+		std::filesystem::rename(temporaryPath, path, error);
+		if (!error)
+			return true;
+		std::filesystem::remove(temporaryPath, error);
+		return false;
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <set>
+#include <string>
+
+#include "Implicant.h"
+#include "MappedFile.h"
+#include "TruthTable.h"
+
+namespace logic
+{
+	/**
+	 * Precomputed MDNFs of every completely specified function of up to <code>MAX_VARIABLES</code> variables.
+	 * A function of fewer variables is looked up as the function of <code>MAX_VARIABLES</code> variables that
+	 * doesn't depend on the extra ones, whose MDNFs are the same.
+	 *
+	 * The database is a memory mapped file made of a header, a table of offsets indexed by the 16-bit truth table
+	 * of the function, and the entries. An entry is the number of MDNFs followed by each MDNF: the number of its
+	 * implicants and a byte for each implicant, whose high half is the form and low half the mask.
+	 */
+	class MDNFDatabase
+	{
+		MappedFile file;
+		bool isValid = false;
+
+		/** @return Offset of entry <code>i</code>, which entry <code>i + 1</code> starts at. */
+		size_t GetOffset(size_t i) const;
+
+	public:
+		static constexpr unsigned char MAX_VARIABLES = 4;
+		static constexpr size_t FUNCTION_COUNT = 1U << (1U << MAX_VARIABLES);
+
+		/** Opens the database at <code>path</code>. If it doesn't exist or is invalid, the database is left closed. */
+		explicit MDNFDatabase(const std::string &path);
+
+		/**
+		 * @return The database built along with the program, whose path is given by the <code>MDNF_DATABASE_PATH</code>
+		 * compile definition. It is opened on the first call.
+		 */
+		static const MDNFDatabase &GetDefault();
+
+		/**
+		 * Computes the MDNFs of all functions and writes the database to <code>path</code>. The file is
+		 * replaced atomically, so a running program never reads a partially written database.
+		 * @return Whether the database was written.
+		 */
+		static bool Generate(const std::string &path);
+
+		/**
+		 * @param index - Will contain the index of the function in the database.
+		 * @return Whether the function is in the database, i.e. whether it has at most <code>MAX_VARIABLES</code>
+		 * variables and no don't care minterms.
+		 */
+		static bool GetIndex(const TruthTable &table, size_t &index);
+
+		bool IsOpen() const
+		{ return isValid; }
+
+		/**
+		 * @return Whether the function was found, in which case <code>mdnfs</code> contains its MDNFs.
+		 */
+		bool Find(const TruthTable &table, std::set<DNF> &mdnfs) const;
+	};
+}
@@ -0,0 +1,66 @@
+#include <thread>
+
+#include "MDNFEnumerator.h"
+#include "McCluskey.h"
+#include "CoverTable.h"
+
+namespace logic
+{
+	MDNFEnumerator::MDNFEnumerator(const TruthTable &table)
+	{
+		Initialize(table);
+	}
+
+	MDNFEnumerator::MDNFEnumerator(unsigned char nVariables, const DNF &dnf, const DNF &dontCare)
+	{
+		Initialize(TruthTable(nVariables, dnf, dontCare));
+	}
+
+	void MDNFEnumerator::Initialize(const TruthTable &table)
+	{
+		GetPrimeImplicants(table, primeImplicants, std::thread::hardware_concurrency());
+		std::vector<ullong> minterms;
+		table.ForEachRequired([&minterms](ullong minterm) {
+			minterms.push_back(minterm);
+		});
+		CoverTable coverTable(primeImplicants, minterms);
+		coverTable.Reduce();
+		for (auto row : coverTable.GetEssentialRows())
+		{
+			essentialImplicants.insert(primeImplicants[row]);
+			essentialCost += coverTable.GetRowCost(row);
+		}
+		if (coverTable.IsSolved())
+			return;
+		// Only the minimum cost is searched for now, the covers are enumerated on demand
+		solver.reset(new CoverSolver(coverTable));
+		solver->StartEnumeration(solver->FindMinimumCost(std::thread::hardware_concurrency()));
+	}
+
+	bool MDNFEnumerator::Next(DNF &mdnf)
+	{
+		if (finished)
+			return false;
+		if (solver == nullptr)
+		{ // The essential implicants are the only minimal form
+			finished = true;
+			mdnf = essentialImplicants;
+			return true;
+		}
+		std::vector<size_t> cover;
+		if (!solver->NextCover(cover))
+		{
+			finished = true;
+			return false;
+		}
+		mdnf = essentialImplicants;
+		for (auto row : cover)
+			mdnf.insert(primeImplicants[row]);
+		return true;
+	}
+
+	int MDNFEnumerator::GetCost() const
+	{
+		return essentialCost + (solver == nullptr ? 0 : solver->GetMinimumCost());
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+
+#include "Implicant.h"
+#include "TruthTable.h"
+#include "ImplicantTable.h"
+#include "CoverSolver.h"
+
+namespace logic
+{
+	/**
+	 * Lazy enumeration of the minimal disjunctive normal forms of a logical function.
+	 * The prime implicants and the minimum cost are found when the enumerator is created,
+	 * while the forms themselves are produced one at a time by <code>Next()</code>, so a caller
+	 * that needs only the first few forms never builds the rest.
+	 * The forms are the same as those returned by <code>GetMDNF</code>, but they come in the order
+	 * in which the cover search finds them rather than in the order of <code>std::set<DNF></code>.
+	 */
+	class MDNFEnumerator
+	{
+		ImplicantTable primeImplicants;
+		DNF essentialImplicants;
+		int essentialCost = 0;
+		// Searches the cyclic core of the cover table, null if the essential implicants cover the function on their own
+		std::unique_ptr<CoverSolver> solver;
+		bool finished = false;
+
+		void Initialize(const TruthTable &table);
+
+	public:
+		explicit MDNFEnumerator(const TruthTable &table);
+
+		/**
+		 * @param nVariables - Number of variables of the logical function.
+		 * @param dnf - Base disjunctive normal form that constitutes a logical function.
+		 * @param[optional] dontCare - Don't care combinations, given as arbitrary implicants.
+		 * @throw <code>std::domain_error</code> - If <code>nVariables</code> is 0 or greater than <code>TruthTable::MAX_VARIABLES</code>.
+		 */
+		MDNFEnumerator(unsigned char nVariables, const DNF &dnf, const DNF &dontCare = {});
+
+		/**
+		 * Finds the next minimal disjunctive normal form.
+		 * @param mdnf - Will contain the form if there is one.
+		 * @return <code>false</code> if all forms have already been returned.
+		 */
+		bool Next(DNF &mdnf);
+
+		/** @return The number of letters of each minimal disjunctive normal form. */
+		int GetCost() const;
+	};
+}
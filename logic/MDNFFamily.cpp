@@ -0,0 +1,94 @@
+#include <stdexcept>
+#include <thread>
+
+#include "MDNFFamily.h"
+#include "McCluskey.h"
+#include "CoverTable.h"
+#include "CoverSolver.h"
+
+namespace logic
+{
+	MDNFFamily::MDNFFamily(const TruthTable &table)
+	{
+		Initialize(table);
+	}
+
+	MDNFFamily::MDNFFamily(unsigned char nVariables, const DNF &dnf, const DNF &dontCare)
+	{
+		Initialize(TruthTable(nVariables, dnf, dontCare));
+	}
+
+	void MDNFFamily::Initialize(const TruthTable &table)
+	{
+		GetPrimeImplicants(table, primeImplicants, std::thread::hardware_concurrency());
+		std::vector<ullong> minterms;
+		table.ForEachRequired([&minterms](ullong minterm) {
+			minterms.push_back(minterm);
+		});
+		CoverTable coverTable(primeImplicants, minterms);
+		coverTable.Reduce();
+		for (auto row : coverTable.GetEssentialRows())
+		{
+			essentialImplicants.insert(primeImplicants[row]);
+			cost += coverTable.GetRowCost(row);
+		}
+		if (!coverTable.IsSolved())
+		{
+			CoverSolver solver(coverTable);
+			int coreCost = solver.FindMinimumCost(std::thread::hardware_concurrency());
+			covers = solver.GetCoverFamily(manager, coreCost);
+			cost += coreCost;
+		}
+		counts.emplace(BDDManager::ZERO, 0);
+		counts.emplace(BDDManager::ONE, 1);
+		Count(covers);
+	}
+
+	const numeric::BigUnsigned &MDNFFamily::Count(BDDManager::Node node)
+	{
+		auto it = counts.find(node);
+		if (it != counts.end())
+			return it->second;
+		auto count = Count(manager.GetLow(node)) + Count(manager.GetHigh(node));
+		return counts[node] = std::move(count);
+	}
+
+	const numeric::BigUnsigned &MDNFFamily::GetCount() const
+	{
+		return counts.at(covers);
+	}
+
+	int MDNFFamily::GetCost() const
+	{
+		return cost;
+	}
+
+	DNF MDNFFamily::Get(numeric::BigUnsigned index) const
+	{
+		if (!(index < GetCount()))
+			throw std::out_of_range("There is no form at the given index");
+		// The sets of the low child, which don't contain the variable of the node, come first
+		DNF mdnf = essentialImplicants;
+		for (auto node = covers; node != BDDManager::ONE;)
+		{
+			auto &lowCount = counts.at(manager.GetLow(node));
+			if (index < lowCount)
+				node = manager.GetLow(node);
+			else
+			{
+				index -= lowCount;
+				mdnf.insert(primeImplicants[manager.GetVariable(node)]);
+				node = manager.GetHigh(node);
+			}
+		}
+		return mdnf;
+	}
+
+	std::vector<DNF> MDNFFamily::GetPage(const numeric::BigUnsigned &first, size_t count) const
+	{
+		std::vector<DNF> page;
+		for (auto index = first; page.size() < count && index < GetCount(); index += 1)
+			page.push_back(Get(index));
+		return page;
+	}
+}
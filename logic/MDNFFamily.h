@@ -0,0 +1,79 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "Implicant.h"
+#include "TruthTable.h"
+#include "ImplicantTable.h"
+#include "BDD.h"
+#include "../numeric/BigUnsigned.h"
+
+namespace logic
+{
+	/**
+	 * All minimal disjunctive normal forms of a logical function, stored as a ZDD over the indices
+	 * of its prime implicants instead of one form at a time (see <code>CoverSolver::GetCoverFamily()</code>).
+	 * Forms that make the same choices share the nodes of the diagram, so its size depends on the structure
+	 * of the cover table rather than on the number of forms, which grows combinatorially on some
+	 * symmetric functions. The forms can be counted, drawn at random and read a page at a time by their index,
+	 * and only the forms that are returned are ever built.
+	 * Forms are indexed in the order of the diagram, which is deterministic but differs from that of
+	 * <code>std::set<DNF></code>.
+	 */
+	class MDNFFamily
+	{
+		ImplicantTable primeImplicants;
+		DNF essentialImplicants;
+		int cost = 0;
+		BDDManager manager;
+		// Covers of the cyclic core of the cover table, without the essential implicants
+		BDDManager::Node covers = BDDManager::ONE;
+		// Number of covers in the family of each node of the diagram
+		std::unordered_map<BDDManager::Node, numeric::BigUnsigned> counts;
+
+		void Initialize(const TruthTable &table);
+
+		const numeric::BigUnsigned &Count(BDDManager::Node node);
+
+	public:
+		explicit MDNFFamily(const TruthTable &table);
+
+		/**
+		 * @param nVariables - Number of variables of the logical function.
+		 * @param dnf - Base disjunctive normal form that constitutes a logical function.
+		 * @param[optional] dontCare - Don't care combinations, given as arbitrary implicants.
+		 * @throw <code>std::domain_error</code> - If <code>nVariables</code> is 0 or greater than <code>TruthTable::MAX_VARIABLES</code>.
+		 */
+		MDNFFamily(unsigned char nVariables, const DNF &dnf, const DNF &dontCare = {});
+
+		/** @return The number of minimal disjunctive normal forms. */
+		const numeric::BigUnsigned &GetCount() const;
+
+		/** @return The number of letters of each minimal disjunctive normal form. */
+		int GetCost() const;
+
+		/**
+		 * @return The form at <code>index</code>.
+		 * @throw <code>std::out_of_range</code> - If <code>index</code> is not less than <code>GetCount()</code>.
+		 */
+		DNF Get(numeric::BigUnsigned index) const;
+
+		/**
+		 * @return At most <code>count</code> consecutive forms, starting with the one at <code>first</code>.
+		 */
+		std::vector<DNF> GetPage(const numeric::BigUnsigned &first, size_t count) const;
+
+		/**
+		 * @return A form drawn uniformly at random.
+		 * @param generator - Random number generator, such as <code>std::mt19937_64</code>.
+		 */
+		template<class Generator>
+		DNF Sample(Generator &generator) const
+		{ return Get(numeric::BigUnsigned::Random(GetCount(), generator)); }
+
+		/** @return The number of nodes of the diagram of the forms. */
+		size_t GetNodeCount() const
+		{ return counts.size(); }
+	};
+}
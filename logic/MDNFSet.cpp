@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <map>
+
+#include "MDNFSet.h"
+
+namespace logic
+{
+	MDNFSet::MDNFSet(ImplicantTable implicants, size_t nEssential) : implicants(std::move(implicants)),
+																	 nEssential(nEssential)
+	{}
+
+	MDNFSet::MDNFSet(const std::set<DNF> &mdnfs)
+	{
+		if (mdnfs.empty())
+			return;
+		// Implicants of the first form that are in all the others are essential
+		DNF essential;
+		for (auto &implicant : *mdnfs.begin())
+			if (std::all_of(std::next(mdnfs.begin()), mdnfs.end(), [&implicant](const DNF &dnf) {
+				return dnf.find(implicant) != dnf.end();
+			}))
+				essential.insert(implicant);
+		for (auto &implicant : essential)
+			implicants.PushBack(implicant);
+		nEssential = essential.size();
+
+		std::map<Implicant, uint32_t> indices;
+		std::vector<uint32_t> form;
+		for (auto &dnf : mdnfs)
+		{
+			form.clear();
+			for (auto &implicant : dnf)
+			{
+				if (essential.find(implicant) != essential.end())
+					continue;
+				auto it = indices.emplace(implicant, indices.size()).first;
+				if (it->second == implicants.GetSize() - nEssential)
+					implicants.PushBack(implicant);
+				form.push_back(it->second);
+			}
+			Add(form.begin(), form.end());
+		}
+	}
+
+	DNF MDNFSet::GetDNF(size_t i) const
+	{
+		DNF dnf;
+		ForEachImplicant(i, [&dnf](const Implicant &implicant) {
+			dnf.insert(implicant);
+		});
+		return dnf;
+	}
+
+	std::set<DNF> MDNFSet::ToSet() const
+	{
+		std::set<DNF> mdnfs;
+		for (size_t i = 0; i < GetSize(); ++i)
+			mdnfs.insert(GetDNF(i));
+		return mdnfs;
+	}
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "Implicant.h"
+#include "ImplicantTable.h"
+
+namespace logic
+{
+	/**
+	 * Compact set of the minimal disjunctive normal forms of a function. All forms share a single table
+	 * of the implicants that appear in any of them: the essential implicants, which are part of every form,
+	 * come first, and each form only stores the indices of the other implicants it selects.
+	 * Unlike <code>std::set<DNF></code>, this doesn't copy the essential implicants into every form
+	 * and doesn't allocate a tree node per implicant.
+	 * The forms are kept in the order in which they were added.
+	 */
+	class MDNFSet
+	{
+		ImplicantTable implicants;
+		size_t nEssential = 0;
+		// The selected implicants of form i are those at indices nEssential + selected[j],
+		// for j in [offsets[i], offsets[i + 1])
+		std::vector<uint32_t> selected;
+		std::vector<size_t> offsets{0};
+
+	public:
+		MDNFSet() = default;
+
+		/**
+		 * Creates an empty set of forms.
+		 * @param implicants - Table of all implicants used by the forms that will be added.
+		 * @param nEssential - Number of implicants at the beginning of the table that are part of every form.
+		 */
+		MDNFSet(ImplicantTable implicants, size_t nEssential);
+
+		/** Converts a set of forms, finding the implicants they all share. */
+		explicit MDNFSet(const std::set<DNF> &mdnfs);
+
+		/**
+		 * Adds a form made of the essential implicants and the implicants at indices
+		 * <code>nEssential + i</code> for each <code>i</code> in [begin, end).
+		 */
+		template<class Iterator>
+		void Add(Iterator begin, Iterator end)
+		{
+			selected.insert(selected.end(), begin, end);
+			offsets.push_back(selected.size());
+		}
+
+		/**
+		 * @return A set of the same forms, each of whose implicants is mapped by <code>function</code>.
+		 * The mapping should be injective, e.g. a permutation or negation of the variables.
+		 */
+		template<class Function>
+		MDNFSet Map(Function function) const
+		{
+			MDNFSet result(*this);
+			result.implicants.Clear();
+			for (size_t i = 0; i < implicants.GetSize(); ++i)
+				result.implicants.PushBack(function(implicants[i]));
+			return result;
+		}
+
+		/** Calls <code>function</code> with each implicant of form <code>i</code>. */
+		template<class Function>
+		void ForEachImplicant(size_t i, Function function) const
+		{
+			for (size_t j = 0; j < nEssential; ++j)
+				function(implicants[j]);
+			for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+				function(implicants[nEssential + selected[j]]);
+		}
+
+		/**
+		 * Calls <code>function</code> with the index of each implicant of form <code>i</code> that is not essential,
+		 * relative to the first implicant that is not essential.
+		 */
+		template<class Function>
+		void ForEachSelected(size_t i, Function function) const
+		{
+			for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+				function(selected[j]);
+		}
+
+		// Getters
+
+		/** @return The number of forms. */
+		size_t GetSize() const
+		{ return offsets.size() - 1; }
+
+		bool IsEmpty() const
+		{ return GetSize() == 0; }
+
+		/** @return The number of implicants of form <code>i</code>. */
+		size_t GetImplicantCount(size_t i) const
+		{ return nEssential + offsets[i + 1] - offsets[i]; }
+
+		/** @return The table of the implicants shared by all forms, starting with the essential ones. */
+		const ImplicantTable &GetImplicants() const
+		{ return implicants; }
+
+		size_t GetEssentialCount() const
+		{ return nEssential; }
+
+		/** @return Form <code>i</code> as a <code>DNF</code>. */
+		DNF GetDNF(size_t i) const;
+
+		/** @return All forms as <code>DNF</code>s. */
+		std::set<DNF> ToSet() const;
+	};
+}
@@ -0,0 +1,34 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedFile.h"
+
+namespace logic
+{
+	MappedFile::MappedFile(const std::string &path)
+	{
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return;
+		struct stat status{};
+		if (fstat(fd, &status) == 0 && status.st_size > 0)
+		{
+			void *address = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+			if (address != MAP_FAILED)
+			{
+				data = static_cast<const unsigned char *>(address);
+				size = status.st_size;
+			}
+		}
+		// The mapping stays valid after the descriptor is closed
+		close(fd);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (data != nullptr)
+			munmap(const_cast<unsigned char *>(data), size);
+	}
+}
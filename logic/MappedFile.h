@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+
+namespace logic
+{
+	/**
+	 * Read-only memory mapping of a whole file. The mapping is released when the object is destroyed.
+	 * @note Uses POSIX <code>mmap</code>.
+	 */
+	class MappedFile
+	{
+		const unsigned char *data = nullptr;
+		size_t size = 0;
+
+	public:
+		/**
+		 * Maps the file at <code>path</code>. If the file can't be opened or mapped, or if it is empty,
+		 * the object is left closed.
+		 */
+		explicit MappedFile(const std::string &path);
+
+		MappedFile(const MappedFile &) = delete;
+
+		MappedFile &operator=(const MappedFile &) = delete;
+
+		~MappedFile();
+
+		bool IsOpen() const
+		{ return data != nullptr; }
+
+		const unsigned char *GetData() const
+		{ return data; }
+
+		size_t GetSize() const
+		{ return size; }
+	};
+}
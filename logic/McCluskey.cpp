@@ -1,24 +1,62 @@
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <limits>
+#include <thread>
 #include "McCluskey.h"
+#include "BDD.h"
+#include "CoverTable.h"
+#include "CoverSolver.h"
+#include "ImplicantHashSet.h"
+#include "MDNFDatabase.h"
+#include "../numeric/NumericGeneral.h"
 
 namespace logic
 {
-	DNF Combine(const DNF &implicants, bool &arePrime, DNF &primeImplicants)
+	ImplicantTable Combine(const ImplicantTable &implicants, bool &arePrime, ImplicantTable &primeImplicants)
 	{
-		//TODO Which assumptions can I make regarding the ordering?
-		DNF returnSet;
-		primeImplicants.insert(implicants.begin(), implicants.end());
+		// Two implicants can only be combined if they have the same mask and their
+		// forms differ in a single bit, i.e. the popcounts of their forms are neighbours.
+		// Most combined implicants are produced by several pairs, so they are deduplicated on the fly
+		ImplicantHashSet returnSet(implicants.GetSize());
 		arePrime = true;
-		for (auto it1 = implicants.begin(); it1 != implicants.end(); ++it1)
-			for (auto it2 = std::next(it1, 1); it2 != implicants.end(); ++it2)
-				if (it1->CanCombineWith(*it2))
-				{
-					returnSet.insert(Combine(*it1, *it2));
-					primeImplicants.erase(*it1);
-					primeImplicants.erase(*it2);
-					arePrime = false;
-				}
-		return returnSet;
+		for (auto &group : implicants.GroupByMask())
+		{
+			ullong mask = group.masks[0];
+			std::vector<bool> combined(group.size, false);
+			// buckets[k] contains indices of the implicants whose form has k set bits
+			std::vector<std::vector<size_t>> buckets(numeric::PopCount(mask) + 1);
+			for (size_t i = 0; i < group.size; ++i)
+				buckets[numeric::PopCount(group.forms[i])].push_back(i);
+			for (size_t k = 0; k + 1 < buckets.size(); ++k)
+				for (auto i : buckets[k])
+					for (auto j : buckets[k + 1])
+					{
+						ullong difference = group.forms[i] ^ group.forms[j];
+						if (numeric::IsPowerOf2(difference))
+						{
+							returnSet.Insert(group.forms[i], mask ^ difference);
+							combined[i] = combined[j] = true;
+							arePrime = false;
+						}
+					}
+			for (size_t i = 0; i < group.size; ++i)
+				if (!combined[i])
+					primeImplicants.PushBack(group.forms[i], mask);
+		}
+		ImplicantTable returnTable = returnSet.ToTable();
+		returnTable.PartitionByMask();
+		return returnTable;
+	}
+
+	DNF Combine(const DNF &implicants, bool &arePrime, DNF &primeImplicants)
+	{
+		ImplicantTable primes, returnTable = Combine(ImplicantTable(implicants), arePrime, primes);
+		for (size_t i = 0; i < primes.GetSize(); ++i)
+			primeImplicants.insert(primes[i]);
+		// The public interface returns implicants in DNF order
+		returnTable.Sort();
+		return returnTable.ToDNF();
 	}
 
 	bool AreCoveredBy(
@@ -37,91 +75,311 @@ namespace logic
 		return true;
 	}
 
-	std::set<DNF> GetMDNF(unsigned char nVariables, DNF dnf, const DNF &dontCare)
+	/**
+	 * Appends all prime implicants of the function of <code>n</code> variables whose ON and don't care
+	 * minterms are given by the bitmap <code>care</code> to <code>primeImplicants</code>, in no particular order.
+	 */
+	void _GetPrimeImplicants(unsigned char n, const std::vector<ullong> &care, ImplicantTable &primeImplicants)
 	{
-		ConvertToCanonicalSumOfProducts(nVariables, dnf);
-		dnf.insert(dontCare.begin(), dontCare.end());
-		std::set<DNF> returnSet;
-		DNF implicants = dnf, primeImplicants;
+		ullong nWords = care.size(), fullMask = full_mask(n);
+		std::vector<ullong> combined(nWords, 0);
+		ImplicantTable implicants;
+		// The first iteration of McCluskey is done on whole words: minterms m and m | 2^v
+		// (where bit v of m is clear) can be combined if both of them are present in the table.
+		for (unsigned char v = 0; v < n; ++v)
+		{
+			ullong sampler = 1ULL << v;
+			for (ullong i = 0; i < nWords; ++i)
+			{
+				// Bit b of "pairs" is set if minterm 64i+b can be combined with its neighbour
+				ullong pairs;
+				if (v < TruthTable::WORD_BITS)
+				{
+					pairs = care[i] & (care[i] >> sampler) & ~TruthTable::VARIABLE_PATTERNS[v];
+					combined[i] |= pairs | (pairs << sampler);
+				}
+				else
+				{
+					ullong neighbour = i | (1ULL << (v - TruthTable::WORD_BITS));
+					if (neighbour == i)
+						continue;
+					pairs = care[i] & care[neighbour];
+					combined[i] |= pairs;
+					combined[neighbour] |= pairs;
+				}
+				for (; pairs; pairs &= pairs - 1)
+					implicants.PushBack((i << TruthTable::WORD_BITS) | numeric::CountTrailingZeros(pairs), fullMask ^ sampler);
+			}
+		}
+		// Minterms that could not be combined with any other minterm are prime implicants themselves
+		for (ullong i = 0; i < nWords; ++i)
+			for (ullong word = care[i] & ~combined[i]; word; word &= word - 1)
+				primeImplicants.PushBack((i << TruthTable::WORD_BITS) | numeric::CountTrailingZeros(word), fullMask);
+		implicants.PartitionByMask();
 		bool arePrime = false;
 		while (!arePrime)
 			implicants = Combine(implicants, arePrime, primeImplicants);
-		// At this point, all prime implicants have been found and placed into "primeImplicants"
-		// We clear "implicants" because we will use it to store essential implicants
-		implicants.clear();
-		/* We have to remove all DNFs that are covered by only one implicant
-		 * and we have to remove such implicants from "primeImplicants" for more efficient generation
-		 * of DNFs. We will store those implicants in "implicants", so we can add
-		 * them to our final result.
-		 */
-		for (auto it = dnf.begin(); it != dnf.end();)
+	}
+
+	void GetPrimeImplicants(const TruthTable &table, ImplicantTable &primeImplicants)
+	{
+		std::vector<ullong> care(table.GetWordCount());
+		for (ullong i = 0; i < care.size(); ++i)
+			care[i] = table.CareWord(i);
+		_GetPrimeImplicants(table.GetVariableCount(), care, primeImplicants);
+		primeImplicants.Sort();
+	}
+
+	void GetPrimeImplicants(const TruthTable &table, ImplicantTable &primeImplicants, unsigned nThreads)
+	{
+		unsigned char n = table.GetVariableCount();
+		// Split variables are taken from the top, so that every cofactor is a contiguous range of whole words.
+		// Cofactors that are too small are not worth a thread
+		constexpr unsigned char MIN_COFACTOR_VARIABLES = 10;
+		unsigned char k = 0;
+		while ((1U << k) < nThreads && n - k > MIN_COFACTOR_VARIABLES)
+			++k;
+		if (k == 0)
 		{
-			auto minterm = *it;
-			// Looks if "term" is a don't care combination - if yes, it is removed from "dnf"
-			if (dontCare.find(minterm) != dontCare.end())
-				it = dnf.erase(it);
+			// On a single thread, large functions are cheaper to handle implicitly
+			constexpr unsigned char MIN_IMPLICIT_VARIABLES = 14;
+			if (n >= MIN_IMPLICIT_VARIABLES)
+				GetImplicitPrimeImplicants(table, primeImplicants);
 			else
+				GetPrimeImplicants(table, primeImplicants);
+			return;
+		}
+		// Node d (a base 3 number with one digit per split variable) stands for the product of the cofactors
+		// in which a variable of digit 0 is 0, of digit 1 is 1, and of digit 2 is either of them
+		size_t nNodes = 1, nCofactorWords = table.GetWordCount() >> k;
+		for (unsigned char j = 0; j < k; ++j)
+			nNodes *= 3;
+		std::vector<ImplicantTable> primes(nNodes);
+		std::atomic<size_t> nextNode(0);
+		auto worker = [&]() {
+			for (size_t node; (node = nextNode++) < nNodes;)
 			{
-				// Counts the number of implicants that cover "minterm". An iterator to the first such implicant is stored in "itImplicant"
-				int implicantCounter = 0;
-				decltype(primeImplicants.begin()) itImplicant;
-				for (auto it1 = primeImplicants.begin(); it1 != primeImplicants.end(); ++it1)
-					if (*it1 << minterm) // This implicant covers "minterm"
-					{
-						if (++implicantCounter == 2) break;
-						itImplicant = it1;
-					}
-				// If only one implicant covers "minterm", it is added to "implicants" and "minterm" is removed from "dnf"
-				if (implicantCounter == 1)
+				std::vector<ullong> care(nCofactorWords, ~0ULL);
+				for (ullong assignment = 0; assignment < (1ULL << k); ++assignment)
 				{
-					implicants.insert(*itImplicant);
-					// Finds all minterms that are covered by this implicant and removes them from consideration
-					for (auto it1 = dnf.begin(); it1 != dnf.end();)
-						if (*itImplicant << *it1)
-							it1 = dnf.erase(it1);
-						else
-							++it1;
-					it = dnf.begin();
+					bool matches = true;
+					for (size_t j = 0, digits = node; j < k && matches; ++j, digits /= 3)
+						matches = digits % 3 == 2 || digits % 3 == ((assignment >> j) & 1);
+					if (matches)
+						for (ullong i = 0; i < nCofactorWords; ++i)
+							care[i] &= table.CareWord(assignment * nCofactorWords + i);
 				}
-				else ++it;
+				_GetPrimeImplicants(n - k, care, primes[node]);
 			}
-		}
-		// If no implicants other than essential implicants are needed, then we can just return those essential implicants
-		if (dnf.empty()) return {implicants};
-		// Now we loop through all possible combinations of our prime implicants, excluding essential implicants
-		int maxSize = primeImplicants.size(), minLetters = std::numeric_limits<int>::max();
-		for (int size = 1; size <= maxSize && size < minLetters; ++size)
+		};
+		std::vector<std::thread> threads;
+		for (unsigned i = 1; i < nThreads; ++i)
+			threads.emplace_back(worker);
+		worker();
+		for (auto &thread : threads)
+			thread.join();
+		// The split variables are merged back one by one. An implicant of the product of both cofactors of x
+		// (the consensus of an implicant of each) is prime iff it is prime in the product, so
+		// P(f) = P(f0 f1) + x'(P(f0) - P(f0 f1)) + x(P(f1) - P(f0 f1))
+		for (unsigned char j = 0; j < k; ++j)
 		{
-			// Creates the base combination of prime implicants (increasing sequence)
-			auto combination = CreateCombination(primeImplicants, size);
-			do
+			ullong sampler = 1ULL << (n - k + j);
+			size_t nMerged = primes.size() / 3;
+			std::vector<ImplicantTable> merged(nMerged);
+			for (size_t node = 0; node < nMerged; ++node)
 			{
-				ullong numOfLetters = 0;
-				// Tests if the current combination of implicants is a valid irreducible DNF and forms a set accordingly
-				if (AreCoveredBy(dnf, combination))
-				{
-					DNF IDNF;
-					for (auto &iterImplicant : combination)
-					{
-						auto implicant = *iterImplicant;
-						numOfLetters += implicant.GetVariableCount();
-						IDNF.insert(implicant);
-					}
-					if (numOfLetters == minLetters) // Keep this IDNF until we find a more favorable one (if ever)
-					{
-						IDNF.insert(implicants.begin(), implicants.end());
-						returnSet.insert(IDNF);
-					}
-					else if (numOfLetters < minLetters) // This IDNF has fewer letters than all others => the others are not MDNFs
-					{
-						minLetters = numOfLetters;
-						IDNF.insert(implicants.begin(), implicants.end());
-						returnSet = {IDNF};
-					}
-				}
-			} while (NextCombination(combination, primeImplicants.end()));
+				// The lowest remaining digit is the one of variable j
+				const ImplicantTable &negative = primes[3 * node], &positive = primes[3 * node + 1],
+						&both = primes[3 * node + 2];
+				ImplicantHashSet common(both.GetSize());
+				for (size_t i = 0; i < both.GetSize(); ++i)
+					common.Insert(both.GetForm(i), both.GetMask(i));
+				merged[node] = both;
+				for (size_t i = 0; i < negative.GetSize(); ++i)
+					if (!common.Contains(negative.GetForm(i), negative.GetMask(i)))
+						merged[node].PushBack(negative.GetForm(i), negative.GetMask(i) | sampler);
+				for (size_t i = 0; i < positive.GetSize(); ++i)
+					if (!common.Contains(positive.GetForm(i), positive.GetMask(i)))
+						merged[node].PushBack(positive.GetForm(i) | sampler, positive.GetMask(i) | sampler);
+			}
+			primes = std::move(merged);
+		}
+		primeImplicants.Append(primes[0]);
+		primeImplicants.Sort();
+	}
+
+	void GetImplicitPrimeImplicants(const TruthTable &table, ImplicantTable &primeImplicants)
+	{
+		BDDManager manager;
+		auto primes = manager.GetPrimeImplicants(manager.FromCareSet(table));
+		primeImplicants.Reserve(primeImplicants.GetSize() + manager.Count(primes));
+		manager.ToImplicants(primes, table.GetVariableCount(), primeImplicants);
+		primeImplicants.Sort();
+	}
+
+	DNF GetPrimeImplicants(const TruthTable &table)
+	{
+		ImplicantTable primeImplicants;
+		GetPrimeImplicants(table, primeImplicants);
+		return primeImplicants.ToDNF();
+	}
+
+	DNF GetPrimeImplicants(const TruthTable &table, unsigned nThreads)
+	{
+		ImplicantTable primeImplicants;
+		GetPrimeImplicants(table, primeImplicants, nThreads);
+		return primeImplicants.ToDNF();
+	}
+
+	/**
+	 * @return All minimal covers of <code>minterms</code> by prime implicants from <code>primeImplicants</code>.
+	 * @param minterms - Indices of minterms that have to be covered. Must not contain don't care combinations.
+	 */
+	MDNFSet _GetMinimalCovers(const ImplicantTable &primeImplicants, const std::vector<ullong> &minterms,
+							  unsigned nThreads = 0)
+	{
+		return GetMinimalCovers(primeImplicants, CoverTable(primeImplicants, minterms), nThreads);
+	}
+
+	MDNFSet GetMinimalCovers(const ImplicantTable &primeImplicants, CoverTable table, unsigned nThreads)
+	{
+		// Essential implicants are extracted and dominance rules are applied, which leaves the cyclic core of the table
+		table.Reduce();
+		ImplicantTable implicants;
+		for (auto row : table.GetEssentialRows())
+			implicants.PushBack(primeImplicants[row]);
+		size_t nEssential = implicants.GetSize();
+		// If no implicants other than essential implicants are needed, the only cover is the empty one.
+		// Otherwise, the cyclic core is covered by an exact search.
+		std::vector<std::vector<size_t>> covers{{}};
+		if (!table.IsSolved())
+			covers = CoverSolver(table).Solve(nThreads != 0 ? nThreads : std::thread::hardware_concurrency());
+		// Each cover only keeps the indices of its rows among those used by any cover,
+		// instead of a copy of the essential implicants and its own rows
+		std::vector<size_t> usedRows;
+		for (auto &cover : covers)
+			usedRows.insert(usedRows.end(), cover.begin(), cover.end());
+		std::sort(usedRows.begin(), usedRows.end());
+		usedRows.erase(std::unique(usedRows.begin(), usedRows.end()), usedRows.end());
+		for (auto row : usedRows)
+			implicants.PushBack(primeImplicants[row]);
+		MDNFSet mdnfs(std::move(implicants), nEssential);
+		std::vector<uint32_t> indices;
+		for (auto &cover : covers)
+		{
+			indices.clear();
+			for (auto row : cover)
+				indices.push_back(std::lower_bound(usedRows.begin(), usedRows.end(), row) - usedRows.begin());
+			mdnfs.Add(indices.begin(), indices.end());
 		}
-		return returnSet;
+		return mdnfs;
+	}
+
+	std::set<DNF> GetMDNF(unsigned char nVariables, DNF dnf, const DNF &dontCare)
+	{
+		if (nVariables > 0 && nVariables <= TruthTable::MAX_VARIABLES)
+			return GetMDNF(TruthTable(nVariables, dnf, dontCare));
+		ConvertToCanonicalSumOfProducts(nVariables, dnf);
+		dnf.insert(dontCare.begin(), dontCare.end());
+		ImplicantTable implicants(dnf), primeImplicants;
+		bool arePrime = false;
+		while (!arePrime)
+			implicants = Combine(implicants, arePrime, primeImplicants);
+		primeImplicants.Sort();
+		// At this point, all prime implicants have been found and placed into "primeImplicants"
+		std::vector<ullong> minterms;
+		for (auto &minterm : dnf)
+			if (dontCare.find(minterm) == dontCare.end())
+				minterms.push_back(minterm.GetForm());
+		return _GetMinimalCovers(primeImplicants, minterms).ToSet();
+	}
+
+	std::set<DNF> GetMDNF(const TruthTable &table)
+	{
+		std::set<DNF> mdnfs;
+		if (MDNFDatabase::GetDefault().Find(table, mdnfs))
+			return mdnfs;
+		return ComputeMDNF(table);
+	}
+
+	MDNFSet GetMDNFSet(const TruthTable &table, unsigned nThreads)
+	{
+		std::set<DNF> mdnfs;
+		if (MDNFDatabase::GetDefault().Find(table, mdnfs))
+			return MDNFSet(mdnfs);
+		return ComputeMDNFSet(table, nThreads);
+	}
+
+	std::set<DNF> ComputeMDNF(const TruthTable &table)
+	{
+		return ComputeMDNFSet(table).ToSet();
+	}
+
+	MDNFSet ComputeMDNFSet(const TruthTable &table, unsigned nThreads)
+	{
+		if (nThreads == 0)
+			nThreads = std::thread::hardware_concurrency();
+		ImplicantTable primeImplicants;
+		GetPrimeImplicants(table, primeImplicants, nThreads);
+		std::vector<ullong> minterms;
+		table.ForEachRequired([&minterms](ullong minterm) {
+			minterms.push_back(minterm);
+		});
+		return _GetMinimalCovers(primeImplicants, minterms, nThreads);
+	}
+
+	CNF Negate(const DNF &dnf)
+	{
+		CNF cnf;
+		for (auto &implicant : dnf)
+			cnf.emplace(~implicant.GetForm() & implicant.GetMask(), implicant.GetMask());
+		return cnf;
+	}
+
+	std::set<CNF> GetMCNF(const TruthTable &table)
+	{
+		std::set<CNF> mcnfs;
+		for (auto &mdnf : GetMDNF(table.GetComplement()))
+			mcnfs.insert(Negate(mdnf));
+		return mcnfs;
+	}
+
+	std::set<CNF> GetMCNF(unsigned char nVariables, const DNF &dnf, const DNF &dontCare)
+	{
+		return GetMCNF(TruthTable(nVariables, dnf, dontCare));
+	}
+
+	MinimizeResult Minimize(const TruthTable &table, const MinimizeOptions &options)
+	{
+		unsigned nThreads = options.nThreads != 0 ? options.nThreads : std::thread::hardware_concurrency();
+		ImplicantTable primeImplicants;
+		GetPrimeImplicants(table, primeImplicants, nThreads);
+		std::vector<ullong> minterms;
+		table.ForEachRequired([&minterms](ullong minterm) {
+			minterms.push_back(minterm);
+		});
+		CoverTable coverTable(primeImplicants, minterms);
+		coverTable.Reduce();
+		MinimizeResult result{{}, true};
+		for (auto row : coverTable.GetEssentialRows())
+			result.dnf.insert(primeImplicants[row]);
+		if (coverTable.IsSolved())
+			return result;
+		// The greedy cover is the answer until the exact search finds a cheaper one
+		auto cover = coverTable.GetGreedyCover();
+		int cost = 0;
+		for (auto row : cover)
+			cost += coverTable.GetRowCost(row);
+		result.isMinimal = CoverSolver(coverTable).FindMinimumCover(cover, cost, options.deadline, options.nodeBudget,
+																	nThreads);
+		for (auto row : cover)
+			result.dnf.insert(primeImplicants[row]);
+		return result;
+	}
+
+	MinimizeResult Minimize(unsigned char nVariables, const DNF &dnf, const DNF &dontCare, const MinimizeOptions &options)
+	{
+		return Minimize(TruthTable(nVariables, dnf, dontCare), options);
 	}
 
 	std::string ToLiteral(const DNF &dnf, unsigned char n)
@@ -146,6 +404,24 @@ namespace logic
 		return literal;
 	}
 
+	std::string ToConjunctiveLiteral(const CNF &cnf, unsigned char n)
+	{
+		std::string literal;
+		for (auto &clause : cnf)
+		{
+			// A clause is written like an implicant whose letters are separated by +
+			std::string letters = clause.ToLiteral(n), sum;
+			for (size_t i = 0; i < letters.size(); ++i)
+			{
+				if (i != 0 && letters[i] != '\'')
+					sum += '+';
+				sum += letters[i];
+			}
+			literal += clause.GetVariableCount() > 1 ? '(' + sum + ')' : sum;
+		}
+		return literal;
+	}
+
 	void PrintMDNF(unsigned char nVariables, const DNF &minterms, const DNF &dontCare)
 	{
 		for (auto &x : GetMDNF(nVariables, minterms, dontCare))
@@ -185,6 +461,11 @@ namespace logic
 
 	void ConvertToCanonicalSumOfProducts(unsigned char nVariables, DNF &dnf)
 	{
+		if (nVariables > 0 && nVariables <= TruthTable::MAX_VARIABLES)
+		{
+			dnf = TruthTable(nVariables, dnf).ToDNF();
+			return;
+		}
 		DNF newDNF;
 		ullong mintermMask = (1ULL << nVariables) - 1;
 		for (auto x : dnf)
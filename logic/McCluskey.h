@@ -1,6 +1,12 @@
 #pragma once
 
+#include <chrono>
+
 #include "Implicant.h"
+#include "TruthTable.h"
+#include "ImplicantTable.h"
+#include "MDNFSet.h"
+#include "CoverTable.h"
 
 namespace logic
 {
@@ -18,6 +24,17 @@ Implicant Combine(Implicant x, const Implicant &y);
  */
 DNF Combine(const DNF &implicants, bool &arePrime, DNF &primeImplicants);
 
+/**
+ * Performs one iteration of McCluskey on implicants stored in an <code>ImplicantTable</code>.
+ * Implicants are grouped by mask and, within a group, bucketed by the number of set bits in their form.
+ * Only implicants from neighbouring buckets are compared.
+ * @param implicants - Table of all implicants from the previous iteration (or minterms), sorted or partitioned by mask.
+ * @param arePrime - Will be set to <code>true</code> if the result contains all prime implicants, <code>false</code> otherwise.
+ * @param primeImplicants - Implicants that cannot be combined with other implicants are appended to this table.
+ * @return Table of simplified implicants without duplicates, partitioned by mask.
+ */
+ImplicantTable Combine(const ImplicantTable &implicants, bool &arePrime, ImplicantTable &primeImplicants);
+
 /**
  * @return Whether the logical function specified by <code>minterms</code> is covered by <code>implicants</code>.
  * @param minterms - Set of minterms that form a logical function.
@@ -86,6 +103,46 @@ void ExtrapolateMintermsAndAdd(unsigned char nVariables, const Implicant &implic
  */
 void ConvertToCanonicalSumOfProducts(unsigned char nVariables, DNF &dnf);
 
+/**
+ * Finds all prime implicants of the function given by <code>table</code>. Don't care minterms
+ * are treated as if they were ON. The first iteration of McCluskey is done directly on the
+ * bitmaps of the table, so the function is never expanded into a set of minterms.
+ */
+DNF GetPrimeImplicants(const TruthTable &table);
+
+/**
+ * Finds all prime implicants of the function given by <code>table</code> and appends them to <code>primeImplicants</code>,
+ * which is then sorted.
+ * @see <code>GetPrimeImplicants(const TruthTable &)</code>
+ */
+void GetPrimeImplicants(const TruthTable &table, ImplicantTable &primeImplicants);
+
+/**
+ * Finds all prime implicants of the function given by <code>table</code> on up to <code>nThreads</code> threads.
+ * The function is split on its top k variables into 3^k independent products of cofactors (for each split
+ * variable x: the cofactor where x is 0, the one where x is 1, and their product), whose prime implicants
+ * are found in parallel and then merged back through consensus on the split variables.
+ * The result is the same as that of the serial version. Small functions are not split, and large functions
+ * that are not split are handled by <code>GetImplicitPrimeImplicants()</code>.
+ * @param nThreads - Maximum number of threads, 0 and 1 meaning the serial version.
+ */
+void GetPrimeImplicants(const TruthTable &table, ImplicantTable &primeImplicants, unsigned nThreads);
+
+/**
+ * @see <code>GetPrimeImplicants(const TruthTable &, ImplicantTable &, unsigned)</code>
+ */
+DNF GetPrimeImplicants(const TruthTable &table, unsigned nThreads);
+
+/**
+ * Finds all prime implicants of the function given by <code>table</code> implicitly: the function is turned into
+ * a BDD, whose prime implicants are found as a ZDD by <code>BDDManager::GetPrimeImplicants()</code>.
+ * Intermediate results are never enumerated and their size depends on the structure of the function
+ * rather than on the number of implicants, so this needs far less memory than McCluskey on functions with
+ * many prime implicants. Only the final ZDD is converted into implicants, which are appended to
+ * <code>primeImplicants</code>, which is then sorted.
+ */
+void GetImplicitPrimeImplicants(const TruthTable &table, ImplicantTable &primeImplicants);
+
 /**
  * @param nVariables Number of variables of the logical function.
  * @param dnf - Base disjunctive normal form that constitutes a logical function.
@@ -94,6 +151,108 @@ void ConvertToCanonicalSumOfProducts(unsigned char nVariables, DNF &dnf);
  */
 std::set<DNF> GetMDNF(unsigned char nVariables, DNF dnf, const DNF &dontCare = {});
 
+/**
+ * @return Set of minimal disjunctive normal forms for the logical function given by <code>table</code>.
+ * Small completely specified functions are read from <code>MDNFDatabase::GetDefault()</code>,
+ * the others are minimized by <code>ComputeMDNF()</code>.
+ */
+std::set<DNF> GetMDNF(const TruthTable &table);
+
+/**
+ * Minimizes the logical function given by <code>table</code> without looking it up in the database.
+ * Prime implicants are generated on all hardware threads.
+ * @return Set of minimal disjunctive normal forms of the function.
+ */
+std::set<DNF> ComputeMDNF(const TruthTable &table);
+
+/**
+ * @return All minimal covers of the columns of <code>table</code>, as forms made of the prime implicants of its rows.
+ * Only the prime implicants that are used by some cover are kept.
+ * @param primeImplicants - Prime implicant of each row of the table.
+ * @param table - Table that has not been reduced yet.
+ * @param nThreads - Number of threads of the cover search, 0 meaning all hardware threads.
+ */
+MDNFSet GetMinimalCovers(const ImplicantTable &primeImplicants, CoverTable table, unsigned nThreads = 0);
+
+/**
+ * Same as <code>GetMDNF(const TruthTable &)</code>, but the forms share a single table of implicants.
+ * @param nThreads - Number of threads used on a database miss, 0 meaning all hardware threads.
+ * @see <code>MDNFSet</code>
+ */
+MDNFSet GetMDNFSet(const TruthTable &table, unsigned nThreads = 0);
+
+/**
+ * Same as <code>ComputeMDNF(const TruthTable &)</code>, but the forms share a single table of implicants.
+ * @param nThreads - Number of threads of the prime implicant generation and of the cover search,
+ * 0 meaning all hardware threads.
+ * @see <code>MDNFSet</code>
+ */
+MDNFSet ComputeMDNFSet(const TruthTable &table, unsigned nThreads = 0);
+
+/**
+ * @return The conjunctive normal form of the complement of the function given by <code>dnf</code>, whose clauses
+ * are the implicants of <code>dnf</code> with every letter negated (De Morgan's laws).
+ */
+CNF Negate(const DNF &dnf);
+
+/**
+ * Finds the minimal conjunctive normal forms of the function given by <code>table</code>. The minimal CNFs
+ * are the negated MDNFs of the complement, which is minimized from a truth table complemented word by word,
+ * so the OFF set is never expanded into a set of minterms. Functions with few OFF minterms
+ * have small prime implicant charts this way.
+ * @return Set of minimal conjunctive normal forms of the function.
+ */
+std::set<CNF> GetMCNF(const TruthTable &table);
+
+/**
+ * @param nVariables Number of variables of the logical function.
+ * @param dnf - Base disjunctive normal form that constitutes a logical function.
+ * @param dontCare - Don't care combinations, given as arbitrary implicants.
+ * @throw <code>std::domain_error</code> - If <code>nVariables</code> is 0 or greater than <code>TruthTable::MAX_VARIABLES</code>.
+ * @see <code>GetMCNF(const TruthTable &)</code>
+ */
+std::set<CNF> GetMCNF(unsigned char nVariables, const DNF &dnf, const DNF &dontCare = {});
+
+/**
+ * Limits of an anytime minimization.
+ */
+struct MinimizeOptions
+{
+	/** Point in time at which the search for a cheaper cover stops. No limit by default. */
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+	/** Maximum number of nodes of the search for a cheaper cover, 0 meaning no limit. */
+	ullong nodeBudget = 0;
+	/** Number of threads, 0 meaning all hardware threads. */
+	unsigned nThreads = 0;
+};
+
+/**
+ * Result of an anytime minimization.
+ */
+struct MinimizeResult
+{
+	DNF dnf;
+	/** Whether <code>dnf</code> is proven to be an MDNF, i.e. the search has finished within its limits. */
+	bool isMinimal;
+};
+
+/**
+ * Finds a single minimal (or near-minimal) disjunctive normal form within the limits given by <code>options</code>.
+ * A greedy cover that takes the prime implicants covering the most uncovered minterms per letter
+ * is found first, then the exact search keeps improving it until it either finishes or runs out of budget.
+ * @note The limits apply to the cover search only. The prime implicants are always generated completely.
+ */
+MinimizeResult Minimize(const TruthTable &table, const MinimizeOptions &options);
+
+/**
+ * @param nVariables Number of variables of the logical function.
+ * @param dnf - Base disjunctive normal form that constitutes a logical function.
+ * @param dontCare - Don't care combinations, given as arbitrary implicants.
+ * @throw <code>std::domain_error</code> - If <code>nVariables</code> is 0 or greater than <code>TruthTable::MAX_VARIABLES</code>.
+ * @see <code>Minimize(const TruthTable &, const MinimizeOptions &)</code>
+ */
+MinimizeResult Minimize(unsigned char nVariables, const DNF &dnf, const DNF &dontCare, const MinimizeOptions &options);
+
 /**
  * Takes a disjunctive normal form and returns its textual/mathematical representation.
  * @param dnf - Set of implicants.
@@ -101,6 +260,14 @@ std::set<DNF> GetMDNF(unsigned char nVariables, DNF dnf, const DNF &dontCare = {
  */
 std::string ToLiteral(const DNF &dnf, unsigned char n);
 
+/**
+ * Takes a conjunctive normal form and returns its textual/mathematical representation,
+ * where clauses of more than one letter are enclosed in parentheses.
+ * @param cnf - Set of clauses.
+ * @param n - Number of variables of the logical function.
+ */
+std::string ToConjunctiveLiteral(const CNF &cnf, unsigned char n);
+
 void PrintMDNF(unsigned char nVariables, const DNF &minterms, const DNF &dontCare = {});
 
 }
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include "MultiOutput.h"
+#include "CoverSolver.h"
+#include "CoverTable.h"
+#include "ImplicantHashSet.h"
+
+namespace logic
+{
+	/**
+	 * Outputs of an implicant of the multi-output McCluskey.
+	 */
+	struct _TaggedImplicant
+	{
+		ullong outputs;
+		// Whether the implicant has been combined into an implicant of the same outputs
+		bool isCombined;
+	};
+
+	struct _KeyHash
+	{
+		size_t operator()(ullong key) const
+		{ return ImplicantHashSet::Hash(key & 0xFFFFFFFFULL, key >> 32); }
+	};
+
+	// Implicants of one iteration of the multi-output McCluskey. Since there are at most TruthTable::MAX_VARIABLES
+	// variables, an implicant is keyed on a single word whose upper half is the mask and lower half is the form.
+	using _TaggedImplicants = std::unordered_map<ullong, _TaggedImplicant, _KeyHash>;
+
+	static void _CheckOutputs(const std::vector<TruthTable> &tables)
+	{
+		if (tables.empty() || tables.size() > MAX_OUTPUTS)
+			throw std::domain_error("Illegal number of outputs");
+		for (auto &table : tables)
+			if (table.GetVariableCount() != tables[0].GetVariableCount())
+				throw std::domain_error("All outputs must have the same number of variables");
+	}
+
+	std::vector<MultiOutputImplicant> GetMultiOutputPrimeImplicants(const std::vector<TruthTable> &tables)
+	{
+		_CheckOutputs(tables);
+		// Every minterm is tagged with the outputs that may cover it
+		_TaggedImplicants implicants;
+		ullong mask = tables[0].GetSize() - 1;
+		for (ullong i = 0; i < tables[0].GetWordCount(); ++i)
+		{
+			ullong any = 0;
+			for (auto &table : tables)
+				any |= table.CareWord(i);
+			for (; any; any &= any - 1)
+			{
+				unsigned char bit = numeric::CountTrailingZeros(any);
+				ullong minterm = (i << TruthTable::WORD_BITS) | bit, outputs = 0;
+				for (size_t o = 0; o < tables.size(); ++o)
+					outputs |= (tables[o].CareWord(i) >> bit & 1) << o;
+				implicants.emplace(mask << 32 | minterm, _TaggedImplicant{outputs, false});
+			}
+		}
+
+		std::vector<MultiOutputImplicant> primeImplicants;
+		while (!implicants.empty())
+		{
+			_TaggedImplicants combined;
+			for (auto &implicant : implicants)
+			{
+				ullong key = implicant.first, form = key & 0xFFFFFFFFULL;
+				// Each pair is found from the implicant whose form has a 0 where they differ
+				for (ullong candidates = (key >> 32) & ~form; candidates; candidates &= candidates - 1)
+				{
+					ullong sampler = candidates & -candidates;
+					auto partner = implicants.find(key | sampler);
+					if (partner == implicants.end())
+						continue;
+					// The combined implicant only belongs to the outputs of both halves
+					ullong outputs = implicant.second.outputs & partner->second.outputs;
+					if (outputs == 0)
+						continue;
+					combined.emplace(key & ~(sampler << 32), _TaggedImplicant{outputs, false});
+					implicant.second.isCombined |= outputs == implicant.second.outputs;
+					partner->second.isCombined |= outputs == partner->second.outputs;
+				}
+			}
+			for (auto &implicant : implicants)
+				if (!implicant.second.isCombined)
+					primeImplicants.push_back({Implicant(implicant.first & 0xFFFFFFFFULL, implicant.first >> 32),
+											   implicant.second.outputs});
+			implicants = std::move(combined);
+		}
+		std::sort(primeImplicants.begin(), primeImplicants.end(), [](auto &x, auto &y) {
+			return x.implicant < y.implicant;
+		});
+		return primeImplicants;
+	}
+
+	MultiOutputResult MinimizeMultiOutput(const std::vector<TruthTable> &tables, const MinimizeOptions &options)
+	{
+		auto primeImplicants = GetMultiOutputPrimeImplicants(tables);
+		unsigned nThreads = options.nThreads != 0 ? options.nThreads : std::thread::hardware_concurrency();
+		// Columns are the minterms that have to be covered, output by output
+		std::vector<std::vector<ullong>> minterms(tables.size());
+		std::vector<size_t> firstColumn(tables.size() + 1);
+		for (size_t o = 0; o < tables.size(); ++o)
+		{
+			tables[o].ForEachRequired([&minterms, o](ullong minterm) {
+				minterms[o].push_back(minterm);
+			});
+			firstColumn[o + 1] = firstColumn[o] + minterms[o].size();
+		}
+		// A row covers the minterms of its implicant in all of its outputs, but its cost is only paid once
+		std::vector<int> rowCost;
+		std::vector<std::vector<size_t>> rowColumns;
+		for (auto &prime : primeImplicants)
+		{
+			ullong form = prime.implicant.GetForm(), mask = prime.implicant.GetMask();
+			std::vector<size_t> columns;
+			for (size_t o = 0; o < tables.size(); ++o)
+			{
+				if ((prime.outputs >> o & 1) == 0)
+					continue;
+				// The minterms of the implicant lie between its form and its form with all free variables set
+				auto first = std::lower_bound(minterms[o].begin(), minterms[o].end(), form),
+						last = std::upper_bound(first, minterms[o].end(), form | (~mask & (tables[o].GetSize() - 1)));
+				for (auto it = first; it != last; ++it)
+					if ((*it & mask) == form)
+						columns.push_back(firstColumn[o] + (it - minterms[o].begin()));
+			}
+			rowCost.push_back(numeric::PopCount(mask));
+			rowColumns.push_back(std::move(columns));
+		}
+
+		CoverTable coverTable(std::move(rowCost), std::move(rowColumns), firstColumn.back());
+		coverTable.Reduce();
+		MultiOutputResult result{std::vector<DNF>(tables.size()), true};
+		auto rows = coverTable.GetEssentialRows();
+		if (!coverTable.IsSolved())
+		{
+			// The greedy cover is the answer until the exact search finds a cheaper one
+			auto cover = coverTable.GetGreedyCover();
+			int cost = 0;
+			for (auto row : cover)
+				cost += coverTable.GetRowCost(row);
+			result.isMinimal = CoverSolver(coverTable).FindMinimumCover(cover, cost, options.deadline,
+																		options.nodeBudget, nThreads);
+			rows.insert(rows.end(), cover.begin(), cover.end());
+		}
+
+		// Each output takes the terms of the cover that are implicants of it, except those whose required
+		// minterms are all covered by its other terms. Terms with the most letters are dropped first.
+		std::sort(rows.begin(), rows.end(), [&primeImplicants](size_t x, size_t y) {
+			auto &a = primeImplicants[x].implicant, &b = primeImplicants[y].implicant;
+			int lettersA = numeric::PopCount(a.GetMask()), lettersB = numeric::PopCount(b.GetMask());
+			return lettersA != lettersB ? lettersA > lettersB : a < b;
+		});
+		for (size_t o = 0; o < tables.size(); ++o)
+		{
+			std::vector<Implicant> terms;
+			for (auto row : rows)
+				if (primeImplicants[row].outputs >> o & 1)
+					terms.push_back(primeImplicants[row].implicant);
+			std::vector<unsigned> coverCount(minterms[o].size());
+			auto forEachColumn = [&](const Implicant &term, auto function) {
+				for (size_t j = 0; j < minterms[o].size(); ++j)
+					if ((minterms[o][j] & term.GetMask()) == term.GetForm())
+						function(j);
+			};
+			for (auto &term : terms)
+				forEachColumn(term, [&coverCount](size_t j) {
+					++coverCount[j];
+				});
+			for (auto &term : terms)
+			{
+				bool isRedundant = true;
+				forEachColumn(term, [&](size_t j) {
+					isRedundant &= coverCount[j] > 1;
+				});
+				if (isRedundant)
+					forEachColumn(term, [&coverCount](size_t j) {
+						--coverCount[j];
+					});
+				else
+					result.dnfs[o].insert(term);
+			}
+		}
+		return result;
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+
+#include "Implicant.h"
+#include "McCluskey.h"
+#include "TruthTable.h"
+
+namespace logic
+{
+	/** Maximum number of outputs of a function minimized by <code>MinimizeMultiOutput()</code>. */
+	constexpr unsigned char MAX_OUTPUTS = numeric::LONG_LONG_SIZE;
+
+	/**
+	 * Implicant tagged with the outputs it is an implicant of. Bit <code>i</code> of <code>outputs</code>
+	 * represents output <code>i</code>.
+	 */
+	struct MultiOutputImplicant
+	{
+		Implicant implicant;
+		ullong outputs;
+	};
+
+	/**
+	 * Finds the multi-output prime implicants of a function with several outputs over the same inputs,
+	 * in a single pass over all outputs: each minterm is tagged with the outputs in which it is ON or don't care,
+	 * and combining two implicants keeps the outputs they share. An implicant is prime if no implicant it
+	 * combines into has all of its outputs. A product term shared by several outputs is then a single prime
+	 * implicant, rather than a prime implicant of each output.
+	 * @param tables - Truth table of each output. All tables must have the same number of variables.
+	 * @return Prime implicants sorted in the same order as in a <code>DNF</code>.
+	 * @throw <code>std::domain_error</code> - If there are no tables, more than <code>MAX_OUTPUTS</code> tables
+	 * or tables with different numbers of variables.
+	 */
+	std::vector<MultiOutputImplicant> GetMultiOutputPrimeImplicants(const std::vector<TruthTable> &tables);
+
+	/**
+	 * Result of a multi-output minimization.
+	 */
+	struct MultiOutputResult
+	{
+		/** Minimized DNF of each output. Product terms that appear in several of them are shared. */
+		std::vector<DNF> dnfs;
+		/** Whether the result is proven to be minimal, i.e. the search has finished within its limits. */
+		bool isMinimal;
+	};
+
+	/**
+	 * Minimizes all outputs of a function together. Rows of the prime implicant chart are the multi-output prime
+	 * implicants and its columns are the minterms that have to be covered in each output. The cost of a cover
+	 * is the total number of letters of its distinct product terms, so a term shared by several outputs
+	 * is only paid for once. A single minimal cover is found, as by
+	 * <code>Minimize(const TruthTable &, const MinimizeOptions &)</code>. Each output then gets
+	 * the terms of the cover that are implicants of it, without those that are redundant in that output.
+	 * @param tables - Truth table of each output.
+	 * @throw <code>std::domain_error</code> - Under the same conditions as <code>GetMultiOutputPrimeImplicants()</code>.
+	 */
+	MultiOutputResult MinimizeMultiOutput(const std::vector<TruthTable> &tables, const MinimizeOptions &options = {});
+}
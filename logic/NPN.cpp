@@ -0,0 +1,284 @@
+#include <algorithm>
+
+#include "NPN.h"
+
+namespace logic
+{
+	Implicant NPNTransform::ToCanonical(const Implicant &implicant) const
+	{
+		ullong form = 0, mask = 0;
+		for (size_t i = 0; i < permutation.size(); ++i)
+		{
+			ullong bit = 1ULL << i, original = 1ULL << permutation[i];
+			if (implicant.GetMask() & original)
+			{
+				mask |= bit;
+				if (static_cast<bool>(implicant.GetForm() & original) != static_cast<bool>(inputNegation & bit))
+					form |= bit;
+			}
+		}
+		return {form, mask};
+	}
+
+	Implicant NPNTransform::ToOriginal(const Implicant &implicant) const
+	{
+		ullong form = 0, mask = 0;
+		for (size_t i = 0; i < permutation.size(); ++i)
+		{
+			ullong bit = 1ULL << i, original = 1ULL << permutation[i];
+			if (implicant.GetMask() & bit)
+			{
+				mask |= original;
+				if (static_cast<bool>(implicant.GetForm() & bit) != static_cast<bool>(inputNegation & bit))
+					form |= original;
+			}
+		}
+		return {form, mask};
+	}
+
+	DNF NPNTransform::ToOriginal(const DNF &dnf) const
+	{
+		DNF result;
+		for (auto &implicant : dnf)
+			result.insert(ToOriginal(implicant));
+		return result;
+	}
+
+	MDNFSet NPNTransform::ToOriginal(const MDNFSet &mdnfs) const
+	{
+		return mdnfs.Map([this](const Implicant &implicant) {
+			return ToOriginal(implicant);
+		});
+	}
+
+	/**
+	 * Best transform found so far by the search for the canonical form, along with the bitmaps it produces.
+	 */
+	struct _NPNSearch
+	{
+		unsigned char n;
+		ullong size;
+		std::vector<ullong> on, dontCare, candidateOn, candidateDontCare;
+		NPNTransform transform;
+		bool found = false;
+		ullong nCandidates = 0;
+
+		/** Negates input <code>i</code> of <code>bitmap</code>, which swaps its cofactors. */
+		static void NegateInput(std::vector<ullong> &bitmap, unsigned i)
+		{
+			if (i < TruthTable::WORD_BITS)
+			{
+				ullong pattern = TruthTable::VARIABLE_PATTERNS[i];
+				for (auto &word : bitmap)
+					word = (word & pattern) >> (1U << i) | (word & ~pattern) << (1U << i);
+				return;
+			}
+			ullong bit = 1ULL << (i - TruthTable::WORD_BITS);
+			for (ullong w = 0; w < bitmap.size(); ++w)
+				if ((w & bit) == 0)
+					std::swap(bitmap[w], bitmap[w | bit]);
+		}
+
+		/** Swaps inputs <code>i</code> and <code>j</code> of <code>bitmap</code>, where <code>i</code> is less than <code>j</code>. */
+		static void SwapInputs(std::vector<ullong> &bitmap, unsigned i, unsigned j)
+		{
+			if (j < TruthTable::WORD_BITS)
+			{ // Delta swap of the bits where only i is set with those where only j is set
+				ullong mask = TruthTable::VARIABLE_PATTERNS[i] & ~TruthTable::VARIABLE_PATTERNS[j],
+						delta = (1ULL << j) - (1ULL << i);
+				for (auto &word : bitmap)
+				{
+					ullong t = (word ^ word >> delta) & mask;
+					word ^= t | t << delta;
+				}
+				return;
+			}
+			ullong bitJ = 1ULL << (j - TruthTable::WORD_BITS);
+			if (i < TruthTable::WORD_BITS)
+			{ // The half of a word where i is set is exchanged with the half of its partner word where i isn't
+				ullong pattern = TruthTable::VARIABLE_PATTERNS[i];
+				for (ullong w = 0; w < bitmap.size(); ++w)
+					if ((w & bitJ) == 0)
+					{
+						ullong low = bitmap[w], high = bitmap[w | bitJ];
+						bitmap[w] = (low & ~pattern) | (high & ~pattern) << (1U << i);
+						bitmap[w | bitJ] = (high & pattern) | (low & pattern) >> (1U << i);
+					}
+				return;
+			}
+			ullong bitI = 1ULL << (i - TruthTable::WORD_BITS);
+			for (ullong w = 0; w < bitmap.size(); ++w)
+				if ((w & bitI) != 0 && (w & bitJ) == 0)
+					std::swap(bitmap[w], bitmap[w ^ bitI ^ bitJ]);
+		}
+
+		/**
+		 * Computes the bitmap of the canonical function into <code>result</code>, whose original bitmap
+		 * is <code>source</code>, a word at a time: the inputs are negated first, then brought into their
+		 * canonical order by at most n - 1 swaps.
+		 */
+		void Transform(const std::vector<ullong> &source, const std::vector<unsigned char> &order, ullong negation,
+					   std::vector<ullong> &result) const
+		{
+			result = source;
+			for (unsigned i = 0; i < n; ++i)
+				if (negation >> i & 1)
+					NegateInput(result, order[i]);
+			// current[p] is the original input at position p of the result
+			unsigned char current[TruthTable::MAX_VARIABLES];
+			for (unsigned i = 0; i < n; ++i)
+				current[i] = i;
+			for (unsigned i = 0; i < n; ++i)
+			{
+				unsigned p = std::find(current + i, current + n, order[i]) - current;
+				if (p != i)
+				{
+					SwapInputs(result, i, p);
+					std::swap(current[i], current[p]);
+				}
+			}
+		}
+
+		/**
+		 * Applies the transform to <code>source</code> and keeps it if its bitmaps are smaller than the best ones.
+		 * Words are compared from the highest one.
+		 */
+		void Try(const std::vector<unsigned char> &order, ullong negation, bool outputNegation,
+				 const std::vector<ullong> &sourceOn, const std::vector<ullong> &sourceDontCare)
+		{
+			++nCandidates;
+			Transform(sourceOn, order, negation, candidateOn);
+			Transform(sourceDontCare, order, negation, candidateDontCare);
+			if (found)
+			{
+				int comparison = 0;
+				for (auto pass : {std::make_pair(&candidateOn, &on), std::make_pair(&candidateDontCare, &dontCare)})
+					for (ullong w = on.size(); w-- > 0 && comparison == 0;)
+						if ((*pass.first)[w] != (*pass.second)[w])
+							comparison = (*pass.first)[w] < (*pass.second)[w] ? -1 : 1;
+				if (comparison >= 0)
+					return;
+			}
+			on.swap(candidateOn);
+			dontCare.swap(candidateDontCare);
+			transform.permutation = order;
+			transform.inputNegation = negation;
+			transform.outputNegation = outputNegation;
+			found = true;
+		}
+
+		/**
+		 * Tries every transform allowed by the signatures of the inputs of the function given by
+		 * <code>sourceOn</code> and <code>sourceDontCare</code>.
+		 */
+		void Search(bool outputNegation, const std::vector<ullong> &sourceOn, const std::vector<ullong> &sourceDontCare)
+		{
+			// Sizes of the positive cofactors of each input, as pairs of required and don't care minterms
+			ullong nOn = 0, nDontCare = 0;
+			std::vector<std::pair<ullong, ullong>> positive(n, {0, 0});
+			for (ullong w = 0; w < on.size(); ++w)
+			{
+				nOn += numeric::PopCount(sourceOn[w]);
+				nDontCare += numeric::PopCount(sourceDontCare[w]);
+				for (unsigned i = 0; i < n; ++i)
+				{
+					ullong pattern = i < TruthTable::WORD_BITS ? TruthTable::VARIABLE_PATTERNS[i]
+															   : (w >> (i - TruthTable::WORD_BITS) & 1 ? ~0ULL : 0);
+					positive[i].first += numeric::PopCount(sourceOn[w] & pattern);
+					positive[i].second += numeric::PopCount(sourceDontCare[w] & pattern);
+				}
+			}
+			// Each input is negated if its positive cofactor is the larger one and tried both ways if they are equal
+			std::vector<std::pair<ullong, ullong>> signature(n);
+			ullong forced = 0, ties = 0;
+			for (unsigned i = 0; i < n; ++i)
+			{
+				std::pair<ullong, ullong> negative{nOn - positive[i].first, nDontCare - positive[i].second};
+				if (positive[i] > negative)
+					forced |= 1ULL << i;
+				else if (positive[i] == negative)
+					ties |= 1ULL << i;
+				signature[i] = std::min(positive[i], negative);
+			}
+			std::vector<unsigned char> order(n);
+			for (unsigned i = 0; i < n; ++i)
+				order[i] = i;
+			std::stable_sort(order.begin(), order.end(),
+							 [&signature](unsigned char a, unsigned char b) { return signature[a] < signature[b]; });
+			// Groups of inputs with equal signatures, which are permuted among themselves
+			std::vector<std::pair<size_t, size_t>> groups;
+			for (size_t begin = 0, end; begin < n; begin = end)
+			{
+				for (end = begin + 1; end < n && signature[order[end]] == signature[order[begin]]; ++end);
+				if (end - begin > 1)
+					groups.emplace_back(begin, end);
+			}
+
+			while (true)
+			{
+				ullong originalTies = 0, originalForced = 0;
+				for (unsigned i = 0; i < n; ++i)
+				{
+					originalTies |= (ties >> order[i] & 1) << i;
+					originalForced |= (forced >> order[i] & 1) << i;
+				}
+				// Subsets of the tied inputs
+				ullong subset = 0;
+				do
+				{
+					if (nCandidates == MAX_NPN_CANDIDATES)
+						return;
+					Try(order, originalForced | subset, outputNegation, sourceOn, sourceDontCare);
+					subset = (subset - originalTies) & originalTies;
+				} while (subset != 0);
+
+				// Next permutation of the groups, like an odometer
+				size_t g = 0;
+				for (; g < groups.size(); ++g)
+					if (std::next_permutation(order.begin() + groups[g].first, order.begin() + groups[g].second))
+						break;
+				if (g == groups.size())
+					return;
+			}
+		}
+	};
+
+	TruthTable GetNPNCanonicalForm(const TruthTable &table, NPNTransform &transform, bool allowOutputNegation)
+	{
+		_NPNSearch search;
+		search.n = table.GetVariableCount();
+		search.size = table.GetSize();
+		ullong nWords = table.GetWordCount(), used = search.size < TruthTable::WORD_SIZE ? (1ULL << search.size) - 1 : ~0ULL;
+		std::vector<ullong> on(nWords), dontCare(nWords), off(nWords);
+		ullong nOn = 0, nOff = 0;
+		for (ullong w = 0; w < nWords; ++w)
+		{
+			on[w] = table.RequiredWord(w) & used;
+			dontCare[w] = table.DontCareWord(w) & used;
+			off[w] = ~(on[w] | dontCare[w]) & used;
+			nOn += numeric::PopCount(on[w]);
+			nOff += numeric::PopCount(off[w]);
+		}
+		search.on.resize(nWords);
+		search.dontCare.resize(nWords);
+		search.candidateOn.resize(nWords);
+		search.candidateDontCare.resize(nWords);
+
+		// The output is complemented if that makes the ON set smaller, and tried both ways if it doesn't matter
+		if (!allowOutputNegation || nOn <= nOff)
+			search.Search(false, on, dontCare);
+		if (allowOutputNegation && nOff <= nOn)
+			search.Search(true, off, dontCare);
+
+		transform = search.transform;
+		TruthTable canonical(search.n);
+		for (ullong w = 0; w < nWords; ++w)
+		{
+			for (ullong word = search.on[w]; word; word &= word - 1)
+				canonical.SetOn((w << TruthTable::WORD_BITS) | numeric::CountTrailingZeros(word));
+			for (ullong word = search.dontCare[w]; word; word &= word - 1)
+				canonical.SetDontCare((w << TruthTable::WORD_BITS) | numeric::CountTrailingZeros(word));
+		}
+		return canonical;
+	}
+}
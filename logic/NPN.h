@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+
+#include "Implicant.h"
+#include "MDNFSet.h"
+#include "TruthTable.h"
+
+namespace logic
+{
+	/**
+	 * Transform that takes a logical function to its NPN canonical form: an input permutation,
+	 * an input negation and an optional output complement.
+	 * Minterm <code>c</code> of the canonical function corresponds to minterm <code>m</code> of the original
+	 * function, where bit <code>i</code> of <code>c</code> equals bit <code>permutation[i]</code> of <code>m</code>,
+	 * inverted if bit <code>i</code> of <code>inputNegation</code> is set.
+	 */
+	struct NPNTransform
+	{
+		std::vector<unsigned char> permutation;
+		ullong inputNegation = 0;
+		bool outputNegation = false;
+
+		/** @return The implicant of the canonical function that corresponds to <code>implicant</code>. */
+		Implicant ToCanonical(const Implicant &implicant) const;
+
+		/** @return The implicant of the original function that corresponds to <code>implicant</code> of the canonical one. */
+		Implicant ToOriginal(const Implicant &implicant) const;
+
+		/**
+		 * Maps every implicant of <code>dnf</code> back to the original function. Since the transform
+		 * preserves the number of letters of each implicant, minimal forms are mapped to minimal forms.
+		 * @note Only meaningful if <code>outputNegation</code> is not set, because a sum of products
+		 * of the complement is not a sum of products of the function.
+		 */
+		DNF ToOriginal(const DNF &dnf) const;
+
+		/**
+		 * Maps the shared implicants of <code>mdnfs</code> back to the original function, which maps every form.
+		 * @see <code>ToOriginal(const DNF &)</code>
+		 */
+		MDNFSet ToOriginal(const MDNFSet &mdnfs) const;
+	};
+
+	/** Maximum number of transforms tried by <code>GetNPNCanonicalForm()</code>. */
+	constexpr ullong MAX_NPN_CANDIDATES = 720;
+
+	/**
+	 * Computes the NPN canonical form of a function: the representative of all functions that differ from it
+	 * only by a permutation of the inputs, negation of some inputs and, optionally, complement of the output.
+	 * The representative is the transformed function whose bitmaps of required and don't care minterms are
+	 * lexicographically the smallest, starting from the highest minterm.
+	 *
+	 * Instead of trying all n!·2^n transforms, the search is restricted by signatures that are invariant under
+	 * the transforms: each input is negated so that its positive cofactor has no more minterms than its negative
+	 * one, and inputs are ordered by their cofactor sizes. Only inputs with equal signatures are permuted
+	 * and only inputs whose cofactors are of equal size are tried in both phases.
+	 * @param transform - Will contain the transform from <code>table</code> to its canonical form.
+	 * @param allowOutputNegation - Whether the function may be complemented. Functions with don't care minterms
+	 * are complemented by swapping the ON and OFF sets.
+	 * @note If the signatures leave more than <code>MAX_NPN_CANDIDATES</code> transforms (e.g. for highly symmetric
+	 * functions), only that many are tried. The result is then still equivalent to <code>table</code>, but equivalent
+	 * functions may get different representatives.
+	 */
+	TruthTable GetNPNCanonicalForm(const TruthTable &table, NPNTransform &transform, bool allowOutputNegation = true);
+}
@@ -0,0 +1,290 @@
+#include <charconv>
+#include <map>
+#include <stdexcept>
+
+#include "PLA.h"
+
+namespace logic
+{
+	/**
+	 * Parser of a PLA that reads directly from the stream buffer and keeps track of the line for error messages.
+	 */
+	class _PLAReader
+	{
+		using Traits = std::char_traits<char>;
+
+		std::streambuf *buffer;
+		size_t line = 1;
+		PLA pla;
+		size_t nOutputs = 1;
+		// Whether - in an output means don't care (type fd) rather than nothing (type f)
+		bool hasDontCare = true;
+
+		[[noreturn]] void Error(const std::string &message) const
+		{
+			throw std::domain_error("Line " + std::to_string(line) + ": " + message);
+		}
+
+		int Peek()
+		{ return buffer->sgetc(); }
+
+		int Get()
+		{
+			int c = buffer->sbumpc();
+			if (c == '\n')
+				++line;
+			return c;
+		}
+
+		static bool IsBlank(int c)
+		{ return c == ' ' || c == '\t' || c == '\r'; }
+
+		static bool IsEnd(int c)
+		{ return c == '\n' || c == Traits::eof(); }
+
+		void SkipBlanks()
+		{
+			while (IsBlank(Peek()))
+				Get();
+		}
+
+		void SkipLine()
+		{
+			while (!IsEnd(Peek()))
+				Get();
+			Get();
+		}
+
+		/** Consumes the rest of the line, which may only contain blanks and a comment. */
+		void EndLine()
+		{
+			SkipBlanks();
+			if (Peek() == '#')
+				SkipLine();
+			else if (!IsEnd(Peek()))
+				Error("unexpected character '" + std::string(1, static_cast<char>(Peek())) + "'");
+			else
+				Get();
+		}
+
+		/** Reads a word of a dot-command. Keywords, numbers and labels are short, so they are read into a string. */
+		std::string ReadWord()
+		{
+			SkipBlanks();
+			std::string word;
+			while (!IsBlank(Peek()) && !IsEnd(Peek()))
+				word += static_cast<char>(Get());
+			return word;
+		}
+
+		size_t ReadNumber(size_t min, size_t max)
+		{
+			std::string word = ReadWord();
+			size_t x = 0;
+			auto result = std::from_chars(word.data(), word.data() + word.size(), x);
+			if (word.empty() || result.ec != std::errc() || result.ptr != word.data() + word.size() || x < min || x > max)
+				Error("expected a number between " + std::to_string(min) + " and " + std::to_string(max));
+			return x;
+		}
+
+		/** @return The next symbol of a row. Blanks and | are skipped, but the row may not end before the symbol. */
+		int ReadSymbol()
+		{
+			while (IsBlank(Peek()) || Peek() == '|')
+				Get();
+			if (IsEnd(Peek()))
+				Error("the row is too short");
+			return Get();
+		}
+
+		/**
+		 * Reads the dot-command that starts at the current character.
+		 * @return <code>false</code> if it marks the end of the PLA.
+		 */
+		bool ReadCommand()
+		{
+			Get();
+			std::string keyword = ReadWord();
+			bool hasCubes = !pla.on.empty();
+			if (keyword == "e" || keyword == "end")
+			{
+				// Anything after the end is left in the stream
+				SkipLine();
+				return false;
+			}
+			if (keyword == "i" || keyword == "o")
+			{
+				if (hasCubes)
+					Error("." + keyword + " must precede the cubes");
+				if (keyword == "i")
+					pla.nInputs = ReadNumber(1, numeric::LONG_LONG_SIZE);
+				else
+					nOutputs = ReadNumber(1, 1U << 16);
+			}
+			else if (keyword == "p")
+				ReadNumber(0, ~size_t(0));
+			else if (keyword == "type")
+			{
+				std::string type = ReadWord();
+				if (type != "f" && type != "fd")
+					Error("unsupported type " + type);
+				hasDontCare = type == "fd";
+			}
+			else if (keyword == "ilb" || keyword == "ob")
+			{
+				auto &labels = keyword == "ilb" ? pla.inputLabels : pla.outputLabels;
+				labels.clear();
+				for (std::string label = ReadWord(); !label.empty(); label = ReadWord())
+					labels.push_back(label);
+			}
+			else if (keyword == "mv")
+			{
+				// Only binary inputs followed by a single output variable are supported, which is the same as .i and .o
+				if (hasCubes)
+					Error(".mv must precede the cubes");
+				size_t nVariables = ReadNumber(2, numeric::LONG_LONG_SIZE + 1);
+				if (ReadNumber(0, numeric::LONG_LONG_SIZE) != nVariables - 1)
+					Error("multiple-valued inputs are not supported");
+				pla.nInputs = nVariables - 1;
+				nOutputs = ReadNumber(1, 1U << 16);
+			}
+			else
+			{
+				// Other commands, such as .phase or .label, don't change the function
+				SkipLine();
+				return true;
+			}
+			EndLine();
+			return true;
+		}
+
+		void ReadCube()
+		{
+			if (pla.nInputs == 0)
+				Error(".i must precede the cubes");
+			if (pla.on.empty())
+			{
+				pla.on.resize(nOutputs);
+				pla.dontCare.resize(nOutputs);
+			}
+			ullong form = 0, mask = 0;
+			for (unsigned i = 0; i < pla.nInputs; ++i)
+			{
+				ullong bit = 1ULL << (pla.nInputs - 1 - i);
+				switch (ReadSymbol())
+				{
+					case '1':
+						form |= bit;
+						[[fallthrough]];
+					case '0':
+						mask |= bit;
+						[[fallthrough]];
+					case '-':
+					case '2':
+						break;
+					default:
+						Error("illegal input symbol");
+				}
+			}
+			Implicant implicant(form, mask);
+			for (size_t o = 0; o < nOutputs; ++o)
+				switch (ReadSymbol())
+				{
+					case '1':
+					case '4':
+						pla.on[o].insert(implicant);
+						break;
+					case '-':
+					case '2':
+						if (hasDontCare)
+							pla.dontCare[o].insert(implicant);
+						[[fallthrough]];
+					case '0':
+					case '~':
+					case '3':
+						break;
+					default:
+						Error("illegal output symbol");
+				}
+			EndLine();
+		}
+
+	public:
+		explicit _PLAReader(std::istream &stream) : buffer(stream.rdbuf())
+		{}
+
+		PLA Read()
+		{
+			while (true)
+			{
+				SkipBlanks();
+				int c = Peek();
+				if (c == Traits::eof())
+					break;
+				if (c == '\n')
+					Get();
+				else if (c == '#')
+					SkipLine();
+				else if (c == '.')
+				{
+					if (!ReadCommand())
+						break;
+				}
+				else
+					ReadCube();
+			}
+			if (pla.nInputs == 0)
+				Error(".i is missing");
+			if (pla.on.empty())
+			{
+				pla.on.resize(nOutputs);
+				pla.dontCare.resize(nOutputs);
+			}
+			return std::move(pla);
+		}
+	};
+
+	PLA ReadPLA(std::istream &stream)
+	{
+		return _PLAReader(stream).Read();
+	}
+
+	void WritePLA(std::ostream &stream, const PLA &pla)
+	{
+		size_t nOutputs = pla.on.size();
+		// ON cubes and don't care cubes are written as separate rows, each shared by all the outputs it belongs to
+		std::map<Implicant, std::string> onRows, dontCareRows;
+		bool hasDontCare = false;
+		for (size_t o = 0; o < nOutputs; ++o)
+		{
+			for (auto &implicant : pla.on[o])
+				onRows.emplace(implicant, std::string(nOutputs, '0')).first->second[o] = '1';
+			for (auto &implicant : pla.dontCare[o])
+				dontCareRows.emplace(implicant, std::string(nOutputs, '0')).first->second[o] = '-';
+			hasDontCare |= !pla.dontCare[o].empty();
+		}
+
+		stream << ".i " << +pla.nInputs << "\n.o " << nOutputs << '\n';
+		for (auto labels : {std::make_pair(".ilb", &pla.inputLabels), std::make_pair(".ob", &pla.outputLabels)})
+			if (!labels.second->empty())
+			{
+				stream << labels.first;
+				for (auto &label : *labels.second)
+					stream << ' ' << label;
+				stream << '\n';
+			}
+		stream << ".type " << (hasDontCare ? "fd" : "f") << "\n.p " << onRows.size() + dontCareRows.size() << '\n';
+		std::string cube(pla.nInputs, '-');
+		for (auto rows : {&onRows, &dontCareRows})
+			for (auto &row : *rows)
+			{
+				for (unsigned i = 0; i < pla.nInputs; ++i)
+				{
+					ullong bit = 1ULL << (pla.nInputs - 1 - i);
+					cube[i] = row.first.GetMask() & bit ? (row.first.GetForm() & bit ? '1' : '0') : '-';
+				}
+				stream << cube << ' ' << row.second << '\n';
+			}
+		stream << ".e\n";
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Implicant.h"
+
+namespace logic
+{
+	/**
+	 * Logical functions in the Berkeley PLA format: a header of dot-commands followed by a row for each cube,
+	 * made of a symbol for each input (0, 1 or -) and a symbol for each output (1 for ON, - for don't care,
+	 * 0 or ~ for neither). The first input is variable A. Types f and fd are supported, as is .mv if all
+	 * variables but the output are binary. Other dot-commands, such as .phase, are ignored.
+	 */
+	struct PLA
+	{
+		unsigned char nInputs = 0;
+		// ON set and don't care set of each output
+		std::vector<DNF> on, dontCare;
+		// Names given by .ilb and .ob, empty if the file has none
+		std::vector<std::string> inputLabels, outputLabels;
+	};
+
+	/**
+	 * Parses a PLA from <code>stream</code> one character at a time, building the form and mask of each
+	 * cube directly. Whitespace and | inside a row are ignored. Reading stops at .e, .end or the end of the stream.
+	 * @throw <code>std::domain_error</code> - If the input is not a valid PLA. The message contains the line number.
+	 */
+	PLA ReadPLA(std::istream &stream);
+
+	/**
+	 * Writes <code>pla</code> as type f, or fd if any output has don't care cubes. Cubes shared
+	 * by several outputs are written as a single row.
+	 */
+	void WritePLA(std::ostream &stream, const PLA &pla);
+}
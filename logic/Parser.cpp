@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+
+#include "Parser.h"
+#include "TruthTable.h"
+#include "../numeric/NumericGeneral.h"
+
+namespace logic
+{
+	bool ParseImplicants(std::string_view expression, unsigned char &nVariables, std::vector<Implicant> &implicants,
+						 ParseError &error, char delimiter)
+	{
+		auto fail = [&error](size_t offset, const char *message) {
+			error.offset = offset;
+			error.message = message;
+			return false;
+		};
+		if (nVariables > numeric::LONG_LONG_SIZE)
+			return fail(0, "Illegal number of variables");
+		size_t first = implicants.size();
+		implicants.reserve(first + std::count(expression.begin(), expression.end(), delimiter) + 1);
+
+		// Letter k is mapped to bit 63 - k, since the number of variables may not be known before the end.
+		// The implicants are shifted into place afterwards.
+		int limit = nVariables != 0 ? nVariables : numeric::LONG_LONG_SIZE;
+		ullong form = ~0ULL, mask = 0, letter = 0, used = 0;
+		// Lower case letters count as upper case ones when the number of variables is determined
+		int upperLimit = 0;
+		for (size_t i = 0; i <= expression.size(); ++i)
+		{
+			char c = i < expression.size() ? expression[i] : delimiter;
+			if (c == delimiter)
+			{
+				implicants.emplace_back(form & mask, mask);
+				used |= mask;
+				form = ~0ULL, mask = 0, letter = 0;
+			}
+			else if (c == '\'')
+			{
+				// Only the first apostrophe after a letter negates it
+				form ^= letter;
+				letter = 0;
+			}
+			else if (c >= 'A' && c - 'A' < limit)
+			{
+				letter = 1ULL << (numeric::LONG_LONG_SIZE - 1 - (c - 'A'));
+				mask |= letter;
+				upperLimit = std::max(upperLimit, std::toupper(c) - 'A' + 1);
+			}
+			else
+			{
+				implicants.erase(implicants.begin() + first, implicants.end());
+				return fail(i, nVariables != 0 && c >= 'A' && c <= 'Z' ? "Letter exceeds the number of variables"
+																		: "Illegal character");
+			}
+		}
+		if (nVariables == 0)
+		{
+			if (used == 0)
+			{
+				implicants.erase(implicants.begin() + first, implicants.end());
+				return fail(0, "No variables found");
+			}
+			int n = numeric::LONG_LONG_SIZE - numeric::CountTrailingZeros(used);
+			if (n > upperLimit)
+			{
+				implicants.erase(implicants.begin() + first, implicants.end());
+				auto it = std::find_if(expression.begin(), expression.end(), [upperLimit, delimiter](char c) {
+					return c != delimiter && c != '\'' && c - 'A' >= upperLimit;
+				});
+				return fail(it - expression.begin(), "Letter exceeds the number of variables");
+			}
+			nVariables = n;
+		}
+		unsigned shift = numeric::LONG_LONG_SIZE - nVariables;
+		for (size_t i = first; i < implicants.size(); ++i)
+			implicants[i] = Implicant(implicants[i].GetForm() >> shift, implicants[i].GetMask() >> shift);
+		return true;
+	}
+
+	bool ParseDNF(std::string_view expression, unsigned char &nVariables, DNF &dnf, ParseError &error, char delimiter)
+	{
+		std::vector<Implicant> implicants;
+		if (!ParseImplicants(expression, nVariables, implicants, error, delimiter))
+			return false;
+		std::sort(implicants.begin(), implicants.end());
+		for (auto &implicant : implicants)
+			dnf.emplace_hint(dnf.end(), implicant);
+		return true;
+	}
+
+	bool ParseMinterms(std::string_view list, unsigned char &nVariables, DNF &dnf, ParseError &error)
+	{
+		auto fail = [&error, &list](const char *position, const char *message) {
+			error.offset = position - list.data();
+			error.message = message;
+			return false;
+		};
+		if (nVariables > numeric::LONG_LONG_SIZE)
+			return fail(list.data(), "Illegal number of variables");
+		// Ranges are collected first, since the number of variables may not be known before the end
+		std::vector<std::pair<ullong, ullong>> ranges;
+		ranges.reserve(std::count(list.begin(), list.end(), ',') + 1);
+		ullong largest = 0;
+		const char *position = list.data(), *end = list.data() + list.size();
+		auto readIndex = [&](ullong &index) {
+			while (position != end && *position == ' ')
+				++position;
+			auto result = std::from_chars(position, end, index);
+			if (result.ec == std::errc::result_out_of_range)
+				return fail(position, "Minterm index is too large");
+			if (result.ec != std::errc())
+				return fail(position, "Expected a minterm index");
+			if (nVariables != 0 && nVariables < numeric::LONG_LONG_SIZE && index >> nVariables)
+				return fail(position, "Minterm index exceeds the number of variables");
+			position = result.ptr;
+			return true;
+		};
+		while (true)
+		{
+			ullong first, last;
+			if (!readIndex(first))
+				return false;
+			last = first;
+			if (position != end && *position == '-')
+			{
+				const char *rangeStart = position++;
+				if (!readIndex(last))
+					return false;
+				if (last < first)
+					return fail(rangeStart, "Range is empty");
+			}
+			ranges.emplace_back(first, last);
+			largest = std::max(largest, last);
+			if (position == end)
+				break;
+			if (*position++ != ',')
+				return fail(position - 1, "Expected a comma");
+		}
+		if (nVariables == 0)
+			nVariables = largest ? numeric::LONG_LONG_SIZE - numeric::CountLeadingZeros(largest) : 1;
+
+		// Each range is split into blocks whose size is a power of two and which are aligned to their size
+		ullong mask = full_mask(nVariables);
+		std::vector<Implicant> implicants;
+		implicants.reserve(ranges.size());
+		for (auto range : ranges)
+			for (ullong first = range.first;;)
+			{
+				ullong size = first ? first & -first : 1ULL << (numeric::LONG_LONG_SIZE - 1);
+				while (size - 1 > range.second - first)
+					size >>= 1;
+				implicants.emplace_back(first, mask & ~(size - 1));
+				if (range.second - first == size - 1)
+					break;
+				first += size;
+			}
+		std::sort(implicants.begin(), implicants.end());
+		for (auto &implicant : implicants)
+			dnf.emplace_hint(dnf.end(), implicant);
+		return true;
+	}
+
+	bool ParseBitmap(std::string_view text, unsigned char &nVariables, std::vector<ullong> &bitmap, ParseError &error)
+	{
+		auto fail = [&error](size_t offset, const char *message) {
+			error.offset = offset;
+			error.message = message;
+			return false;
+		};
+		if (text.size() < 3 || text[0] != '0' || (text[1] != 'x' && text[1] != 'b'))
+			return fail(0, "Expected a truth table starting with 0x or 0b");
+		unsigned digitBits = text[1] == 'x' ? 4 : 1;
+		size_t nDigits = text.size() - 2;
+		// Number of variables for which 2^n bits take exactly nDigits digits. A single hexadecimal digit
+		// is taken as 2 variables, 1 variable needs an explicit count.
+		unsigned char n = nVariables;
+		if (n == 0)
+			for (n = digitBits == 4 ? 2 : 1; n < TruthTable::MAX_VARIABLES && ((1ULL << n) + digitBits - 1) / digitBits < nDigits;)
+				++n;
+		if (n == 0 || n > TruthTable::MAX_VARIABLES || ((1ULL << n) + digitBits - 1) / digitBits != nDigits)
+			return fail(2, "The number of digits doesn't match the number of variables");
+
+		std::vector<ullong> words(((1ULL << n) + TruthTable::WORD_SIZE - 1) / TruthTable::WORD_SIZE, 0);
+		// Digits are read from the least significant one, whose bits belong to the lowest minterms
+		ullong bit = 0;
+		for (size_t i = text.size(); i-- > 2; bit += digitBits)
+		{
+			char c = text[i];
+			ullong value;
+			if (c >= '0' && c <= '9')
+				value = c - '0';
+			else if (c >= 'a' && c <= 'f')
+				value = c - 'a' + 10;
+			else if (c >= 'A' && c <= 'F')
+				value = c - 'A' + 10;
+			else
+				return fail(i, "Illegal digit");
+			if (value >> digitBits || (bit + digitBits > (1ULL << n) && value >> ((1ULL << n) - bit)))
+				return fail(i, "Illegal digit");
+			words[bit / TruthTable::WORD_SIZE] |= value << (bit % TruthTable::WORD_SIZE);
+		}
+		nVariables = n;
+		bitmap = std::move(words);
+		return true;
+	}
+}
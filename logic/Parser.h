@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Implicant.h"
+
+namespace logic
+{
+	/** Description of the first error found by a parser and the offset of the character at which it was found. */
+	struct ParseError
+	{
+		size_t offset = 0;
+		std::string message;
+	};
+
+	/**
+	 * Parses a sum of products such as <code>AB'C+A'D</code> in a single pass, without copying any part of it.
+	 * Letter <code>'A' + k</code> is variable k, an apostrophe negates the letter before it and an empty term
+	 * is the constant 1.
+	 * @param nVariables - Number of variables. If 0, it is determined by the largest letter and stored.
+	 * @param implicants - The implicants are appended in the order of the terms. Space for them is reserved in advance.
+	 * @param error - Set if the expression is invalid, in which case <code>implicants</code> is left unchanged.
+	 * @return Whether the expression is valid.
+	 */
+	bool ParseImplicants(std::string_view expression, unsigned char &nVariables, std::vector<Implicant> &implicants,
+						 ParseError &error, char delimiter = '+');
+
+	/**
+	 * Parses a sum of products with <code>ParseImplicants()</code> and adds its implicants to <code>dnf</code>.
+	 * The implicants are sorted first, so the set is built in linear time.
+	 */
+	bool ParseDNF(std::string_view expression, unsigned char &nVariables, DNF &dnf, ParseError &error,
+				  char delimiter = '+');
+
+	/**
+	 * Parses a comma separated list of minterm indices and ranges of indices such as <code>0,5,8-1023</code>
+	 * and adds them to <code>dnf</code>. Each range is added as the few implicants that exactly cover it,
+	 * rather than minterm by minterm.
+	 * @param nVariables - Number of variables. If 0, the smallest number that fits the largest index is stored.
+	 * @param error - Set if the list is invalid, in which case <code>dnf</code> is left unchanged.
+	 * @return Whether the list is valid.
+	 */
+	bool ParseMinterms(std::string_view list, unsigned char &nVariables, DNF &dnf, ParseError &error);
+
+	/**
+	 * Parses a truth table written as a hexadecimal (<code>0x</code>) or binary (<code>0b</code>) number, whose bit
+	 * <code>i</code> is the value of the function for minterm <code>i</code>. The most significant digit comes first.
+	 * @param nVariables - Number of variables. If 0, it is determined by the number of digits and stored.
+	 * Otherwise the number must have exactly the digits needed for 2^nVariables bits.
+	 * @param bitmap - Will contain the bits packed into words, as in <code>TruthTable</code>.
+	 * @return Whether the truth table is valid.
+	 */
+	bool ParseBitmap(std::string_view text, unsigned char &nVariables, std::vector<ullong> &bitmap, ParseError &error);
+}
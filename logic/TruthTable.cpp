@@ -0,0 +1,114 @@
+#include "TruthTable.h"
+
+namespace logic
+{
+	TruthTable::TruthTable(unsigned char nVariables) : nVariables(nVariables)
+	{
+		if (nVariables == 0 || nVariables > MAX_VARIABLES)
+			throw std::domain_error("Illegal number of variables");
+		on = dontCare = std::vector<ullong>(GetWordCount(), 0);
+	}
+
+	TruthTable::TruthTable(unsigned char nVariables, const DNF &dnf, const DNF &dontCare) : TruthTable(nVariables)
+	{
+		Add(dnf);
+		AddDontCare(dontCare);
+	}
+
+	void TruthTable::Fill(std::vector<ullong> &bitmap, const Implicant &implicant)
+	{
+		ForEachWord(implicant, [&bitmap](ullong i, ullong pattern) {
+			bitmap[i] |= pattern;
+			return true;
+		});
+	}
+
+	void TruthTable::Add(const Implicant &implicant)
+	{
+		Fill(on, implicant);
+	}
+
+	void TruthTable::AddDontCare(const Implicant &implicant)
+	{
+		Fill(dontCare, implicant);
+	}
+
+	void TruthTable::Add(const DNF &dnf)
+	{
+		for (auto &implicant : dnf)
+			Add(implicant);
+	}
+
+	void TruthTable::AddDontCare(const DNF &dnf)
+	{
+		for (auto &implicant : dnf)
+			AddDontCare(implicant);
+	}
+
+	void TruthTable::SetOn(ullong minterm, bool value)
+	{
+		ullong sampler = 1ULL << (minterm % WORD_SIZE);
+		on[minterm >> WORD_BITS] = value ? on[minterm >> WORD_BITS] | sampler : on[minterm >> WORD_BITS] & ~sampler;
+	}
+
+	void TruthTable::SetDontCare(ullong minterm, bool value)
+	{
+		ullong sampler = 1ULL << (minterm % WORD_SIZE);
+		dontCare[minterm >> WORD_BITS] = value ? dontCare[minterm >> WORD_BITS] | sampler
+											   : dontCare[minterm >> WORD_BITS] & ~sampler;
+	}
+
+	unsigned char TruthTable::GetVariableCount() const
+	{
+		return nVariables;
+	}
+
+	ullong TruthTable::GetSize() const
+	{
+		return 1ULL << nVariables;
+	}
+
+	ullong TruthTable::GetWordCount() const
+	{
+		return nVariables > WORD_BITS ? 1ULL << (nVariables - WORD_BITS) : 1;
+	}
+
+	bool TruthTable::IsOn(ullong minterm) const
+	{
+		return on[minterm >> WORD_BITS] & (1ULL << (minterm % WORD_SIZE));
+	}
+
+	bool TruthTable::IsDontCare(ullong minterm) const
+	{
+		return dontCare[minterm >> WORD_BITS] & (1ULL << (minterm % WORD_SIZE));
+	}
+
+	DNF TruthTable::ToDNF() const
+	{
+		DNF dnf;
+		// Minterms are visited in ascending order, which is also their order in a DNF
+		ForEachRequired([&](ullong minterm) {
+			dnf.emplace_hint(dnf.end(), minterm, nVariables);
+		});
+		return dnf;
+	}
+
+	TruthTable TruthTable::GetComplement() const
+	{
+		TruthTable complement(*this);
+		// Bits above the size of a table that doesn't fill a word must stay clear
+		ullong valid = GetSize() < WORD_SIZE ? (1ULL << GetSize()) - 1 : ~0ULL;
+		for (ullong i = 0; i < on.size(); ++i)
+			complement.on[i] = ~(on[i] | dontCare[i]) & valid;
+		return complement;
+	}
+
+	DNF TruthTable::ToDontCareDNF() const
+	{
+		DNF dnf;
+		for (ullong i = 0; i < dontCare.size(); ++i)
+			for (ullong word = dontCare[i]; word; word &= word - 1)
+				dnf.emplace_hint(dnf.end(), (i << WORD_BITS) | numeric::CountTrailingZeros(word), nVariables);
+		return dnf;
+	}
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <vector>
+
+#include "Implicant.h"
+#include "symbols.h"
+#include "../numeric/NumericGeneral.h"
+
+namespace logic
+{
+	/**
+	 * Dense representation of a logical function with at most <code>MAX_VARIABLES</code> variables.
+	 * The ON set and the don't care set are stored as bitmaps packed into 64-bit words,
+	 * where bit <code>i</code> of the bitmap represents the minterm of index <code>i</code>.
+	 * @note A minterm that is both in the ON set and in the don't care set is treated as don't care.
+	 */
+	class TruthTable
+	{
+	public:
+		static constexpr unsigned char MAX_VARIABLES = 30;
+		static constexpr unsigned char WORD_SIZE = 64;
+		static constexpr unsigned char WORD_BITS = 6;
+		/** Bit b of <code>VARIABLE_PATTERNS[j]</code> is set iff bit j of b is set. */
+		static constexpr ullong VARIABLE_PATTERNS[WORD_BITS] = {
+				0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+				0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL};
+
+	private:
+		unsigned char nVariables;
+		std::vector<ullong> on, dontCare;
+
+		/**
+		 * Sets all bits of <code>bitmap</code> that represent minterms covered by <code>implicant</code>.
+		 */
+		void Fill(std::vector<ullong> &bitmap, const Implicant &implicant);
+
+	public:
+		/**
+		 * Creates an empty truth table (constant 0) of the specified number of variables.
+		 * @throw <code>std::domain_error</code> - If <code>nVariables</code> is 0 or greater than <code>MAX_VARIABLES</code>.
+		 */
+		explicit TruthTable(unsigned char nVariables);
+
+		/**
+		 * Creates a truth table of the logical function specified by <code>dnf</code> and <code>dontCare</code>.
+		 * Implicants need not be minterms, they are expanded into all the minterms they cover.
+		 */
+		TruthTable(unsigned char nVariables, const DNF &dnf, const DNF &dontCare = {});
+
+		// Modifiers
+
+		/** Adds all minterms covered by <code>implicant</code> to the ON set. */
+		void Add(const Implicant &implicant);
+
+		/** Adds all minterms covered by <code>implicant</code> to the don't care set. */
+		void AddDontCare(const Implicant &implicant);
+
+		void Add(const DNF &dnf);
+
+		void AddDontCare(const DNF &dnf);
+
+		void SetOn(ullong minterm, bool value = true);
+
+		void SetDontCare(ullong minterm, bool value = true);
+
+		/** Replaces word <code>i</code> of the ON set bitmap. Bits above the size of the table must be clear. */
+		void SetOnWord(ullong i, ullong word)
+		{ on[i] = word; }
+
+		/** Replaces word <code>i</code> of the don't care set bitmap. Bits above the size of the table must be clear. */
+		void SetDontCareWord(ullong i, ullong word)
+		{ dontCare[i] = word; }
+
+		// Getters
+
+		unsigned char GetVariableCount() const;
+
+		/** @return The number of minterms of the function, i.e. 2^n. */
+		ullong GetSize() const;
+
+		/** @return The number of 64-bit words used by each of the bitmaps. */
+		ullong GetWordCount() const;
+
+		bool IsOn(ullong minterm) const;
+
+		bool IsDontCare(ullong minterm) const;
+
+		/** @return Word <code>i</code> of the ON set bitmap. */
+		ullong OnWord(ullong i) const
+		{ return on[i]; }
+
+		/** @return Word <code>i</code> of the don't care set bitmap. */
+		ullong DontCareWord(ullong i) const
+		{ return dontCare[i]; }
+
+		/** @return Word <code>i</code> of the bitmap of minterms that must be covered (ON, but not don't care). */
+		ullong RequiredWord(ullong i) const
+		{ return on[i] & ~dontCare[i]; }
+
+		/** @return Word <code>i</code> of the bitmap of minterms that may be covered (ON or don't care). */
+		ullong CareWord(ullong i) const
+		{ return on[i] | dontCare[i]; }
+
+		/**
+		 * Calls <code>function</code> with the index of every minterm that must be covered, in ascending order.
+		 */
+		template<class Function>
+		void ForEachRequired(Function function) const
+		{
+			for (ullong i = 0; i < on.size(); ++i)
+				for (ullong word = RequiredWord(i); word; word &= word - 1)
+					function((i << WORD_BITS) | numeric::CountTrailingZeros(word));
+		}
+
+		/**
+		 * Calls <code>function(i, pattern)</code> for every word <code>i</code> that holds minterms covered by
+		 * <code>implicant</code>, in ascending order, where <code>pattern</code> has a set bit for each of them.
+		 * The words are visited until <code>function</code> returns <code>false</code>.
+		 * @return Whether <code>function</code> has returned <code>true</code> for every word.
+		 */
+		template<class Function>
+		bool ForEachWord(const Implicant &implicant, Function function) const
+		{
+			ullong mask = implicant.GetMask() & full_mask(nVariables), form = implicant.GetForm() & mask;
+			// The lowest WORD_BITS variables select bits within a word...
+			ullong pattern = GetSize() < WORD_SIZE ? (1ULL << GetSize()) - 1 : ~0ULL;
+			for (unsigned char j = 0; j < WORD_BITS && j < nVariables; ++j)
+				if (mask & (1ULL << j))
+					pattern &= form & (1ULL << j) ? VARIABLE_PATTERNS[j] : ~VARIABLE_PATTERNS[j];
+			// ...and the remaining ones select words. Every subset of the free word index bits is visited once.
+			ullong wordForm = form >> WORD_BITS, freeBits = ~(mask >> WORD_BITS) & (on.size() - 1), subset = 0;
+			do
+				if (!function(wordForm | subset, pattern))
+					return false;
+			while ((subset = (subset - freeBits) & freeBits));
+			return true;
+		}
+
+		/**
+		 * @return Truth table of the complement of the function: minterms that are neither ON nor don't care
+		 * become ON and the don't care set stays the same. The bitmaps are complemented word by word.
+		 */
+		TruthTable GetComplement() const;
+
+		/**
+		 * @return Canonical sum of products of the ON set, excluding don't care minterms.
+		 */
+		DNF ToDNF() const;
+
+		/**
+		 * @return Canonical sum of products of the don't care set.
+		 */
+		DNF ToDontCareDNF() const;
+	};
+}
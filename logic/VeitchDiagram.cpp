@@ -29,7 +29,7 @@ namespace logic
 			: VeitchDiagram(nVariables)
 	{
 		if (shouldMinimize)
-			dnf = *GetMDNF(nVariables, dnf, dontCare).begin();
+			MDNFEnumerator(nVariables, dnf, dontCare).Next(dnf);
 		dnf.insert(dontCare.begin(), dontCare.end());
 		for (auto &x : dnf)
 		{
@@ -4,6 +4,7 @@
 
 #include "Implicant.h"
 #include "McCluskey.h"
+#include "MDNFEnumerator.h"
 
 namespace logic
 {
@@ -50,7 +51,7 @@ namespace logic
 		 * filled according to the logical function specified by <code>dnf</code> and <code>dontCare</code> .
 		 * Contours are constructed based on the specified form if <code>shouldMinimize = false</code>
 		 * and on the minimized form otherwise. If there are multiple minimal forms, the first
-		 * one returned by <code>logic::GetMDNF</code> will be used.
+		 * one found by <code>logic::MDNFEnumerator</code> will be used.
 		 * @param nVariables - Number of variables.
 		 * @param dnf - Disjunctive normal form of the logical function.
 		 * @param[optional] dontCare - Minterms that represent don't care combinations.
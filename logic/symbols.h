@@ -10,4 +10,10 @@ namespace logic
 
 	/** Disjunctive normal form */
 	using DNF = std::set<Implicant>;
+
+	/**
+	 * Conjunctive normal form, whose elements are elementary disjunctions (clauses) of the letters in their mask.
+	 * A form bit of 1 means that the letter is not negated.
+	 */
+	using CNF = std::set<Implicant>;
 }
\ No newline at end of file
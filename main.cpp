@@ -12,7 +12,9 @@ using namespace logic;
 
 std::map<std::string, int (*)(const arglist_iter &, const arglist_iter &)> commands = {
 		{"minimize", minimize::minimize},
-		{"veitch",   veitch::veitch}
+		{"veitch",   veitch::veitch},
+		// Used by the build to precompute the MDNF database
+		{"generate-database", minimize::generate_database}
 };
 
 /**
@@ -35,6 +37,13 @@ int execute_command(const arglist_iter &it_arg, const arglist_iter &end)
 	}
 }
 
+// Commands that modify the function of the last minimize command, only available in interactive mode
+std::map<std::string, int (*)(const arglist_iter &, const arglist_iter &)> session_commands = {
+		{"add",       minimize::add_minterms},
+		{"remove",    minimize::remove_minterms},
+		{"dont-care", minimize::set_dont_care}
+};
+
 int interactive()
 {
 	arglist args;
@@ -48,6 +57,8 @@ int interactive()
 		{ // Valid command
 			commands[args[0]](args.begin() + 1, args.end());
 		}
+		else if (session_commands.find(args[0]) != session_commands.end())
+			session_commands[args[0]](args.begin() + 1, args.end());
 		else if (args[0] == "exit")
 		{
 			if (args.size() > 1)
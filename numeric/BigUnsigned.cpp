@@ -0,0 +1,94 @@
+#include <algorithm>
+
+#include "BigUnsigned.h"
+#include "NumericGeneral.h"
+
+namespace numeric
+{
+	BigUnsigned::BigUnsigned(ullong value)
+	{
+		for (; value != 0; value >>= 32)
+			digits.push_back(static_cast<uint32_t>(value));
+	}
+
+	void BigUnsigned::Trim()
+	{
+		while (!digits.empty() && digits.back() == 0)
+			digits.pop_back();
+	}
+
+	BigUnsigned &BigUnsigned::operator+=(const BigUnsigned &x)
+	{
+		digits.resize(std::max(digits.size(), x.digits.size()) + 1, 0);
+		ullong carry = 0;
+		for (size_t i = 0; i < digits.size(); ++i)
+		{
+			carry += digits[i] + (i < x.digits.size() ? ullong(x.digits[i]) : 0);
+			digits[i] = static_cast<uint32_t>(carry);
+			carry >>= 32;
+		}
+		Trim();
+		return *this;
+	}
+
+	BigUnsigned &BigUnsigned::operator-=(const BigUnsigned &x)
+	{
+		ullong borrow = 0;
+		for (size_t i = 0; i < digits.size(); ++i)
+		{
+			ullong subtrahend = (i < x.digits.size() ? ullong(x.digits[i]) : 0) + borrow;
+			borrow = digits[i] < subtrahend;
+			digits[i] = static_cast<uint32_t>(digits[i] + (borrow << 32) - subtrahend);
+		}
+		Trim();
+		return *this;
+	}
+
+	bool BigUnsigned::operator<(const BigUnsigned &x) const
+	{
+		if (digits.size() != x.digits.size())
+			return digits.size() < x.digits.size();
+		return std::lexicographical_compare(digits.rbegin(), digits.rend(), x.digits.rbegin(), x.digits.rend());
+	}
+
+	unsigned BigUnsigned::GetBitCount() const
+	{
+		if (digits.empty())
+			return 0;
+		return 32 * digits.size() - (CountLeadingZeros(digits.back()) - 32);
+	}
+
+	ullong BigUnsigned::ToULL() const
+	{
+		ullong value = 0;
+		for (size_t i = std::min<size_t>(digits.size(), 2); i-- > 0;)
+			value = (value << 32) | digits[i];
+		return value;
+	}
+
+	std::string BigUnsigned::ToString() const
+	{
+		if (digits.empty())
+			return "0";
+		// The number is divided by 10^9 repeatedly, each remainder gives the next 9 decimal digits
+		constexpr uint32_t CHUNK = 1000000000;
+		std::vector<uint32_t> quotient = digits;
+		std::string result;
+		while (!quotient.empty())
+		{
+			ullong remainder = 0;
+			for (size_t i = quotient.size(); i-- > 0;)
+			{
+				ullong current = (remainder << 32) | quotient[i];
+				quotient[i] = static_cast<uint32_t>(current / CHUNK);
+				remainder = current % CHUNK;
+			}
+			while (!quotient.empty() && quotient.back() == 0)
+				quotient.pop_back();
+			for (int i = 0; i < 9 && (remainder != 0 || !quotient.empty()); ++i, remainder /= 10)
+				result.push_back(static_cast<char>('0' + remainder % 10));
+		}
+		std::reverse(result.begin(), result.end());
+		return result;
+	}
+}
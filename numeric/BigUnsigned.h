@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../symbols.h"
+
+namespace numeric
+{
+	/**
+	 * Unsigned integer of arbitrary size, for counts that may not fit into 64 bits.
+	 * Only the operations needed to count and index combinatorial families are supported.
+	 */
+	class BigUnsigned
+	{
+		// Base 2^32 digits, least significant first, without leading zeros
+		std::vector<uint32_t> digits;
+
+		void Trim();
+
+	public:
+		BigUnsigned(ullong value = 0);
+
+		BigUnsigned &operator+=(const BigUnsigned &x);
+
+		/** @note <code>x</code> must not be greater than this number. */
+		BigUnsigned &operator-=(const BigUnsigned &x);
+
+		friend BigUnsigned operator+(BigUnsigned x, const BigUnsigned &y)
+		{ return x += y; }
+
+		friend BigUnsigned operator-(BigUnsigned x, const BigUnsigned &y)
+		{ return x -= y; }
+
+		bool operator<(const BigUnsigned &x) const;
+
+		bool operator==(const BigUnsigned &x) const
+		{ return digits == x.digits; }
+
+		bool operator!=(const BigUnsigned &x) const
+		{ return digits != x.digits; }
+
+		bool IsZero() const
+		{ return digits.empty(); }
+
+		/** @return The number of bits up to the most significant set bit. */
+		unsigned GetBitCount() const;
+
+		/** @return The number modulo 2^64. */
+		ullong ToULL() const;
+
+		/** @return The number in decimal. */
+		std::string ToString() const;
+
+		/**
+		 * @return A number drawn uniformly from [0, bound), by rejecting random numbers of the same bit count.
+		 * @param generator - Random number generator that produces at least 32 random bits, such as std::mt19937_64.
+		 * @note <code>bound</code> must not be 0.
+		 */
+		template<class Generator>
+		static BigUnsigned Random(const BigUnsigned &bound, Generator &generator)
+		{
+			unsigned nBits = bound.GetBitCount();
+			BigUnsigned x;
+			do
+			{
+				x.digits.resize((nBits + 31) / 32);
+				for (auto &digit : x.digits)
+					digit = static_cast<uint32_t>(generator());
+				if (nBits % 32 != 0)
+					x.digits.back() &= (1U << (nBits % 32)) - 1;
+				x.Trim();
+			} while (!(x < bound));
+			return x;
+		}
+	};
+}
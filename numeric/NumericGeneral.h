@@ -11,4 +11,51 @@ namespace numeric
 	{
 		return x != 0 && !(x & (x - 1));
 	}
+
+	/**
+	 * @return The number of set bits in x.
+	 */
+	inline int PopCount(ullong x)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_popcountll(x);
+#else
+		int count = 0;
+		for (; x; x &= x - 1)
+			++count;
+		return count;
+#endif
+	}
+
+	/**
+	 * @return The index of the least significant set bit of x.
+	 * @note The result is undefined if x is 0.
+	 */
+	inline int CountTrailingZeros(ullong x)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctzll(x);
+#else
+		int count = 0;
+		for (; !(x & 1ULL); x >>= 1U)
+			++count;
+		return count;
+#endif
+	}
+
+	/**
+	 * @return The number of zero bits above the most significant set bit of x.
+	 * @note The result is undefined if x is 0.
+	 */
+	inline int CountLeadingZeros(ullong x)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_clzll(x);
+#else
+		int count = 0;
+		for (ullong sampler = 1ULL << 63U; !(x & sampler); sampler >>= 1U)
+			++count;
+		return count;
+#endif
+	}
 }
\ No newline at end of file
@@ -1,3 +1,11 @@
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+
 #include "minimize.h"
 #include "program.h"
 
@@ -13,17 +21,232 @@ const char *help_synopsis()
 const char *help_options()
 {
 	return "\t-m, --minterms\t\t\tSpecify the expression and don't-cares as a list of\n"
-		   "\t\t\t\t\t\t\tminterm indices separated by comma\n"
+		   "\t\t\t\t\t\t\tminterm indices or ranges (0-15) separated by comma\n"
+		   "\t-T, --truth-table\t\tSpecify the expression and don't-cares as truth\n"
+		   "\t\t\t\t\t\t\ttables in hexadecimal (0x...) or binary (0b...),\n"
+		   "\t\t\t\t\t\t\twhose last digit holds minterm 0\n"
 		   "\t-e, --expression\t\tSpecify a literal mathematical expression (Default)\n"
 		   "\t-d, --dont-care\t\t\tSpecify don't care combinations separated by comma\n"
-		   "\t-n, --variable-count\tNumber of variables\n";
+		   "\t-n, --variable-count\tNumber of variables\n"
+		   "\t-p, --pla\t\t\t\tRead the function from the given PLA file, or from\n"
+		   "\t\t\t\t\t\t\tthe standard input if it is -\n";
 }
 
 const char *help_examples()
 {
 	return "\tminimize ABC+ABC'+A'C\n"
 		   "\tminimize -n 4 ABC+AB'C --dont-care ABC' ABC\n"
-		   "\tminimize --minterms -d 0,2,3 0,1,5,10,13,14 \n";
+		   "\tminimize --minterms -d 0,2,3 0,1,5,10,13,14 \n"
+		   "\tminimize --minterms 0-255,1000-1023\n"
+		   "\tminimize --truth-table 0xE8\n"
+		   "\tminimize --heuristic ABCDEFGHIJ+ABCDEFGHIJ'+A'B\n"
+		   "\tminimize --time-limit 100 --minterms 1,3,4,7,9,12,14,19,22,25,28,31\n"
+		   "\tminimize --cache-dir ~/.cache/acpp ABC+ABC'+A'C\n"
+		   "\tminimize --batch functions.txt --threads 4 --minterms\n"
+		   "\tminimize --pla function.pla --write-pla minimized.pla\n"
+		   "\tminimize --cnf --minterms 0-6,8-14\n"
+		   "\tminimize --count --minterms 1-30\n"
+		   "\tminimize --outputs --minterms \"1,2,4,7;3,5,6,7\"\n"
+		   "\tminimize --outputs --pla adder.pla --write-pla -\n";
+}
+
+const char *help_command_options()
+{
+	return "\t-H, --heuristic\t\t\tFind a near-minimal DNF with an Espresso-style heuristic\n"
+		   "\t\t\t\t\t\t\tinstead of all MDNFs. Supports up to 64 variables\n"
+		   "\t-t, --time-limit\t\tFind a single MDNF within the given number of\n"
+		   "\t\t\t\t\t\t\tmilliseconds. If the time runs out, the best DNF\n"
+		   "\t\t\t\t\t\t\tfound so far is shown.\n"
+		   "\t-c, --cache-dir\t\t\tKeep the results in the given directory and reuse\n"
+		   "\t\t\t\t\t\t\tthem in later invocations.\n"
+		   "\t--cache-stats\t\t\tPrint cache hits and misses to the error output.\n"
+		   "\t--cnf\t\t\t\t\tFind minimal conjunctive normal forms (products of\n"
+		   "\t\t\t\t\t\t\tsums) instead, by minimizing the OFF set\n"
+		   "\t--count\t\t\t\t\tPrint the number of MDNFs (or MCNFs) instead of\n"
+		   "\t\t\t\t\t\t\tthe forms, without building each of them\n"
+		   "\t-o, --outputs\t\t\tMinimize several functions of the same variables\n"
+		   "\t\t\t\t\t\t\ttogether, sharing their product terms. Functions\n"
+		   "\t\t\t\t\t\t\tand don't-cares are separated by ;, or given by the\n"
+		   "\t\t\t\t\t\t\toutputs of a PLA\n"
+		   "\t-b, --batch\t\t\t\tMinimize each line of the given file, or of the\n"
+		   "\t\t\t\t\t\t\tstandard input if it is -, as a separate function.\n"
+		   "\t\t\t\t\t\t\tOther options apply to every line. Results are\n"
+		   "\t\t\t\t\t\t\tprinted one line per function, in input order.\n"
+		   "\t-j, --threads\t\t\tNumber of threads used by --batch. (Default: all)\n"
+		   "\t-w, --write-pla\t\t\tWrite the (first) minimized DNF as a PLA to the\n"
+		   "\t\t\t\t\t\t\tgiven file, or to the standard output if it is -\n";
+}
+
+logic::MDNFCache &get_cache()
+{
+	// The memory tier lives as long as the program, which pays off in interactive mode
+	static logic::MDNFCache cache;
+	return cache;
+}
+
+std::set<logic::DNF> get_MDNF(unsigned char n, const logic::DNF &dnf, const logic::DNF &dontCare,
+							  const std::string &cacheDirectory, unsigned nThreads)
+{
+	if (n == 0 || n > logic::TruthTable::MAX_VARIABLES)
+		return logic::GetMDNF(n, dnf, dontCare);
+	return get_MDNF(logic::TruthTable(n, dnf, dontCare), cacheDirectory, nThreads);
+}
+
+std::set<logic::DNF> get_MDNF(const logic::TruthTable &table, const std::string &cacheDirectory, unsigned nThreads)
+{
+	get_cache().SetDirectory(cacheDirectory);
+	return get_cache().GetMDNF(table, nThreads);
+}
+
+int read_PLA(const std::string &path, logic::PLA &pla)
+{
+	std::ifstream file;
+	if (path != "-" && (file.open(path), !file))
+		return std::cerr << path << ": the file could not be opened.\n", -1;
+	try
+	{
+		pla = logic::ReadPLA(path == "-" ? std::cin : file);
+	}
+	catch (std::domain_error &e)
+	{
+		return std::cerr << path << ": " << e.what() << '\n', -1;
+	}
+	return 0;
+}
+
+int read_PLA(const std::string &path, logic::DNF &dnf, logic::DNF &dontCare, unsigned char &n, logic::PLA *labels)
+{
+	logic::PLA pla;
+	eval(read_PLA(path, pla))
+	if (pla.on.size() != 1)
+		return std::cerr << path << ": only PLAs with a single output are supported without --outputs.\n", -1;
+	n = pla.nInputs;
+	dnf = std::move(pla.on[0]);
+	dontCare = std::move(pla.dontCare[0]);
+	if (labels != nullptr)
+	{
+		labels->inputLabels = std::move(pla.inputLabels);
+		labels->outputLabels = std::move(pla.outputLabels);
+	}
+	return 0;
+}
+
+int write_PLA(const std::string &path, const logic::PLA &pla)
+{
+	if (path == "-")
+		return logic::WritePLA(std::cout, pla), 0;
+	std::ofstream file(path);
+	logic::WritePLA(file, pla);
+	if (!file)
+		return std::cerr << path << ": the file could not be written.\n", -1;
+	return 0;
+}
+
+int write_PLA(const std::string &path, unsigned char n, const logic::DNF &dnf, const logic::PLA &labels)
+{
+	logic::PLA pla;
+	pla.nInputs = n;
+	pla.on = {dnf};
+	pla.dontCare = {{}};
+	pla.inputLabels = labels.inputLabels;
+	pla.outputLabels = labels.outputLabels;
+	return write_PLA(path, pla);
+}
+
+std::string to_literal(const logic::DNF &dnf, unsigned char n, const std::vector<std::string> &labels)
+{
+	if (n == 0 || labels.size() != n)
+		return logic::ToLiteral(dnf, n);
+	bool separate = std::any_of(labels.begin(), labels.end(), [](const std::string &label) {
+		return label.size() != 1;
+	});
+	std::string literal;
+	for (auto it = dnf.begin(); it != dnf.end(); ++it)
+	{
+		if (it != dnf.begin())
+			literal += '+';
+		bool first = true;
+		for (unsigned i = 0; i < n; ++i)
+		{
+			ullong bit = 1ULL << (n - 1 - i);
+			if (!(it->GetMask() & bit))
+				continue;
+			if (!first && separate)
+				literal += '*';
+			(literal += labels[i]) += it->GetForm() & bit ? "" : "'";
+			first = false;
+		}
+	}
+	return literal;
+}
+
+session &get_session()
+{
+	static session current;
+	return current;
+}
+
+/**
+ * Applies <code>modify</code> to each minterm given by the arguments, which are lists of minterm indices,
+ * then prints the MDNFs of the modified session function.
+ */
+static int edit_session(const arglist_iter &begin, const arglist_iter &end,
+						void (*modify)(logic::IncrementalMinimizer &, ullong))
+{
+	auto &current = get_session();
+	if (!current.table)
+		return std::cerr << "No function has been minimized yet.\n", -1;
+	if (begin == end)
+		return std::cerr << "No minterms specified.\n", -1;
+	unsigned char n = current.table->GetVariableCount();
+	logic::DNF minterms;
+	for (auto it = begin; it != end; ++it)
+	{
+		logic::DNF dnf;
+		if (!index_list_to_DNF(*it, dnf, n))
+			return -1;
+		minterms.insert(dnf.begin(), dnf.end());
+	}
+	logic::ConvertToCanonicalSumOfProducts(n, minterms);
+	// The prime implicants are found once, later modifications only update them
+	if (!current.minimizer)
+		current.minimizer.emplace(*current.table);
+	for (auto &minterm : minterms)
+		modify(*current.minimizer, minterm.GetForm());
+	std::cout << "The following MDNFs have been found:\n";
+	for (auto &mdnf : current.minimizer->GetMDNF())
+		std::cout << logic::ToLiteral(mdnf, n) << '\n';
+	return 0;
+}
+
+int add_minterms(const arglist_iter &begin, const arglist_iter &end)
+{
+	return edit_session(begin, end, [](logic::IncrementalMinimizer &minimizer, ullong minterm) {
+		minimizer.AddMinterm(minterm);
+	});
+}
+
+int remove_minterms(const arglist_iter &begin, const arglist_iter &end)
+{
+	return edit_session(begin, end, [](logic::IncrementalMinimizer &minimizer, ullong minterm) {
+		minimizer.RemoveMinterm(minterm);
+	});
+}
+
+int set_dont_care(const arglist_iter &begin, const arglist_iter &end)
+{
+	return edit_session(begin, end, [](logic::IncrementalMinimizer &minimizer, ullong minterm) {
+		minimizer.SetDontCare(minterm);
+	});
+}
+
+int generate_database(const arglist_iter &begin, const arglist_iter &end)
+{
+	if (end - begin != 1)
+		return std::cerr << "Usage: generate-database path\n", -1;
+	if (!logic::MDNFDatabase::Generate(*begin))
+		return std::cerr << *begin << ": the database could not be written.\n", -1;
+	return 0;
 }
 
 void help()
@@ -32,77 +255,367 @@ void help()
 			  << "\nOptions:\n"
 			  << "\t-h, --help\t\t\t\tShow this help list\n"
 			  << help_options()
+			  << help_command_options()
+			  << "\nIn interactive mode, the commands add, remove and dont-care followed by\n"
+				 "minterm indices or ranges modify the last minimized function and minimize\n"
+				 "it again, reusing its prime implicants.\n"
 			  << "\nExamples:\n"
 			  << help_examples();
 }
 
 bool index_list_to_DNF(const std::string &s, logic::DNF &dnf, unsigned char &n)
 {
-	// Should n be determined automatically?
-	bool autoN = n == 0;
-	auto stream = std::istringstream(s);
-	std::set<ullong> indices{};
-	while (!stream.eof())
-	{
-		ullong x;
-		if (!(stream >> x) || (!stream.eof() && stream.get() != ','))
-			return false;
-		if (autoN)
-			while (x >= (1ULL << n) || n == 0) ++n;
-		indices.insert(x);
-	}
-	for (auto x : indices)
-		dnf.insert(logic::Implicant(x, n));
-	return true;
+	logic::ParseError error;
+	if (logic::ParseMinterms(s, n, dnf, error))
+		return true;
+	std::cerr << "Offset " << error.offset << ": " << error.message << ".\n";
+	return false;
 }
 
 bool string_to_DNF(const std::string &s, unsigned char &n, logic::DNF &dnf, char delimiter)
 {
-	try
-	{
-		if (n == 0)
-		{ // Scan the string for the largest letter
-			for (auto c : s)
-				if (c != delimiter && c != '\'' && std::toupper(c) - 'A' + 1 > n)
-					n = std::toupper(c) - 'A' + 1;
-		}
-		if (n > numeric::LONG_LONG_SIZE)
-			return false;
-		int j = 0;
-		for (int i = 0; i < s.size(); ++i)
-			if (s[i] == delimiter)
-			{
-				dnf.insert(logic::Implicant(s.substr(j, i - j), n));
-				j = i + 1;
-			}
-		dnf.insert(logic::Implicant(s.substr(j), n));
-	}
-	catch (std::domain_error &e)
-	{
-		return false;
-	}
-	return true;
+	logic::ParseError error;
+	if (logic::ParseDNF(s, n, dnf, error, delimiter))
+		return true;
+	std::cerr << "Offset " << error.offset << ": " << error.message << ".\n";
+	return false;
 }
 
 int minimize(const arglist_iter &begin, const arglist_iter &end, std::set<logic::DNF> *result, logic::DNF *result_dontCare)
 {
 	logic::DNF dnf, dontCare;
 	unsigned char n = 0;
+	bool heuristic = false, showCacheStatistics = false, multiOutput = false, conjunctive = false,
+			countOnly = false;
+	long long timeLimit = -1, nThreads = 0;
+	std::string cacheDirectory, batchPath, plaPath;
+	auto startTime = std::chrono::steady_clock::now();
 
-	eval(extract_input_variables(begin, end, dnf, dontCare, n))
+	// Options exclusive to this command are parsed here, the rest describe the input
+	arglist args;
+	for (auto it = begin; it != end; ++it)
+	{
+		if (*it == "--heuristic" || *it == "-H")
+			heuristic = true;
+		else if (*it == "--time-limit" || *it == "-t")
+		{
+			if (it + 1 == end || !extract_n(*++it, timeLimit) || timeLimit < 0)
+				return std::cerr << "Illegal time limit.\n", -1;
+		}
+		else if (*it == "--cache-dir" || *it == "-c")
+		{
+			if (++it == end)
+				return std::cerr << "No cache directory specified.\n", -1;
+			cacheDirectory = *it;
+		}
+		else if (*it == "--cache-stats")
+			showCacheStatistics = true;
+		else if (*it == "--outputs" || *it == "-o")
+			multiOutput = true;
+		else if (*it == "--cnf")
+			conjunctive = true;
+		else if (*it == "--count")
+			countOnly = true;
+		else if (*it == "--batch" || *it == "-b")
+		{
+			if (++it == end)
+				return std::cerr << "No batch file specified.\n", -1;
+			batchPath = *it;
+		}
+		else if (*it == "--write-pla" || *it == "-w")
+		{
+			if (++it == end)
+				return std::cerr << "No PLA output file specified.\n", -1;
+			plaPath = *it;
+		}
+		else if (*it == "--threads" || *it == "-j")
+		{
+			if (it + 1 == end || !extract_n(*++it, nThreads) || nThreads < 0)
+				return std::cerr << "Illegal thread count.\n", -1;
+		}
+		else
+			args.push_back(*it);
+	}
+
+	if (conjunctive && (result != nullptr || heuristic || multiOutput || !batchPath.empty() || !plaPath.empty()))
+		return std::cerr << "Conjunctive forms are only supported by the exact and time-limited minimization "
+							"of a single function.\n", -1;
+	if (countOnly && (result != nullptr || heuristic || timeLimit >= 0 || multiOutput || !batchPath.empty() ||
+					  !plaPath.empty()))
+		return std::cerr << "Counting is only supported by the exact minimization of a single function.\n", -1;
+
+	if (!batchPath.empty())
+	{
+		if (!plaPath.empty())
+			return std::cerr << "PLA output is not supported in batch mode.\n", -1;
+		if (multiOutput)
+			return std::cerr << "Several outputs are not supported in batch mode.\n", -1;
+		if (std::find(args.begin(), args.end(), "--help") != args.end() ||
+			std::find(args.begin(), args.end(), "-h") != args.end())
+			return help(), 0;
+		std::ifstream file;
+		if (batchPath != "-" && (file.open(batchPath), !file))
+			return std::cerr << batchPath << ": the file could not be opened.\n", -1;
+		return minimize_batch(batchPath == "-" ? std::cin : file, args,
+							  {heuristic, timeLimit, cacheDirectory}, nThreads);
+	}
+
+	if (multiOutput)
+	{
+		if (result != nullptr)
+			return std::cerr << "Several outputs are not supported by this command.\n", -1;
+		if (heuristic)
+			return std::cerr << "Several outputs can't be minimized with the heuristic.\n", -1;
+		logic::PLA outputs;
+		eval(extract_input_variables(args.begin(), args.end(), dnf, dontCare, n, nullptr, &outputs))
+		if (n == 0 || n > logic::TruthTable::MAX_VARIABLES)
+			return std::cerr << "Several outputs are supported for at most " << +logic::TruthTable::MAX_VARIABLES
+							 << " variables.\n", -1;
+		std::vector<logic::TruthTable> tables;
+		for (size_t o = 0; o < outputs.on.size(); ++o)
+			tables.emplace_back(n, outputs.on[o], outputs.dontCare[o]);
+		logic::MinimizeOptions options;
+		if (timeLimit >= 0)
+			options.deadline = startTime + std::chrono::milliseconds(timeLimit);
+		auto minimized = logic::MinimizeMultiOutput(tables, options);
+		if (!plaPath.empty())
+		{
+			outputs.on = std::move(minimized.dnfs);
+			outputs.dontCare.assign(outputs.on.size(), {});
+			return write_PLA(plaPath, outputs);
+		}
+		std::cout << (minimized.isMinimal ? "The following minimal DNFs with shared product terms have been found:\n"
+										  : "The time limit was reached, the following DNFs are not proven minimal:\n");
+		for (size_t o = 0; o < minimized.dnfs.size(); ++o)
+			std::cout << (o < outputs.outputLabels.size() ? outputs.outputLabels[o] : "f" + std::to_string(o + 1))
+					  << " = " << to_literal(minimized.dnfs[o], n, outputs.inputLabels) << '\n';
+		return 0;
+	}
+
+	// A truth table is kept as is, unless it has to be minimized as a DNF
+	std::optional<logic::TruthTable> table;
+	// Labels of the variables, if the function is read from a PLA that names them
+	logic::PLA labels;
+	eval(extract_input_variables(args.begin(), args.end(), dnf, dontCare, n, &table, nullptr, &labels))
+	if (table && (heuristic || result != nullptr))
+	{
+		dnf = table->ToDNF();
+		dontCare = table->ToDontCareDNF();
+		table.reset();
+	}
+
+	logic::MinimizeOptions options;
+	if (timeLimit >= 0)
+	{
+		if (n > logic::TruthTable::MAX_VARIABLES)
+			return std::cerr << "Time limit is supported for at most " << +logic::TruthTable::MAX_VARIABLES
+							 << " variables.\n", -1;
+		options.deadline = startTime + std::chrono::milliseconds(timeLimit);
+	}
+
+	if (countOnly)
+	{
+		if (n == 0 || n > logic::TruthTable::MAX_VARIABLES)
+			return std::cerr << "Counting is supported for at most " << +logic::TruthTable::MAX_VARIABLES
+							 << " variables.\n", -1;
+		auto function = table ? *table : logic::TruthTable(n, dnf, dontCare);
+		// MCNFs are counted as the MDNFs of the complement
+		logic::MDNFFamily family(conjunctive ? function.GetComplement() : function);
+		std::cout << "The number of " << (conjunctive ? "MCNFs" : "MDNFs") << " is:\n"
+				  << family.GetCount().ToString() << '\n';
+		return 0;
+	}
+
+	if (conjunctive)
+	{
+		if (n == 0 || n > logic::TruthTable::MAX_VARIABLES)
+			return std::cerr << "Conjunctive forms are supported for at most " << +logic::TruthTable::MAX_VARIABLES
+							 << " variables.\n", -1;
+		// The OFF set is minimized as the ON set of the complement
+		auto complement = (table ? *table : logic::TruthTable(n, dnf, dontCare)).GetComplement();
+		if (timeLimit >= 0)
+		{
+			auto minimized = logic::Minimize(complement, options);
+			std::cout << (minimized.isMinimal ? "The following MCNF has been found:\n"
+											  : "The time limit was reached, the following CNF is not proven minimal:\n")
+					  << logic::ToConjunctiveLiteral(logic::Negate(minimized.dnf), n) << '\n';
+			return 0;
+		}
+		std::set<logic::CNF> mcnfs;
+		for (auto &mdnf : get_MDNF(complement, cacheDirectory))
+			mcnfs.insert(logic::Negate(mdnf));
+		std::cout << "The following MCNFs have been found:\n";
+		for (auto &mcnf : mcnfs)
+			std::cout << logic::ToConjunctiveLiteral(mcnf, n) << '\n';
+		return 0;
+	}
 
 	if (result != nullptr)
 	{ // We have called this function from another command
-		*result = logic::GetMDNF(n, dnf, dontCare);
+		if (heuristic)
+			*result = {logic::MinimizeHeuristic(n, dnf, dontCare)};
+		else if (timeLimit >= 0)
+			*result = {logic::Minimize(n, dnf, dontCare, options).dnf};
+		else
+			*result = get_MDNF(n, dnf, dontCare, cacheDirectory);
 		if (result_dontCare != nullptr)
 			*result_dontCare = dontCare;
 		return 0;
 	}
 
-	auto mdnfs = logic::GetMDNF(n, dnf, dontCare);
+	if (heuristic)
+	{
+		auto minimized = logic::MinimizeHeuristic(n, dnf, dontCare);
+		if (!plaPath.empty())
+			return write_PLA(plaPath, n, minimized, labels);
+		std::cout << "The following near-minimal DNF has been found:\n"
+				  << to_literal(minimized, n, labels.inputLabels) << '\n';
+		return 0;
+	}
+
+	if (timeLimit >= 0)
+	{
+		auto minimized = table ? logic::Minimize(*table, options) : logic::Minimize(n, dnf, dontCare, options);
+		if (!plaPath.empty())
+			return write_PLA(plaPath, n, minimized.dnf, labels);
+		std::cout << (minimized.isMinimal ? "The following MDNF has been found:\n"
+										  : "The time limit was reached, the following DNF is not proven minimal:\n")
+				  << to_literal(minimized.dnf, n, labels.inputLabels) << '\n';
+		return 0;
+	}
+
+	auto mdnfs = table ? get_MDNF(*table, cacheDirectory) : get_MDNF(n, dnf, dontCare, cacheDirectory);
+	if (!table && n > 0 && n <= logic::TruthTable::MAX_VARIABLES)
+		table.emplace(n, dnf, dontCare);
+	get_session() = {table, std::nullopt};
+	if (!plaPath.empty())
+		return write_PLA(plaPath, n, mdnfs.empty() ? logic::DNF() : *mdnfs.begin(), labels);
 	std::cout << "The following MDNFs have been found:\n";
 	for (auto &mdnf : mdnfs)
-		std::cout << logic::ToLiteral(mdnf, n) << '\n';
+		std::cout << to_literal(mdnf, n, labels.inputLabels) << '\n';
+	if (showCacheStatistics)
+	{
+		auto &statistics = get_cache().GetStatistics();
+		std::cerr << "Cache: " << statistics.memoryHits << " memory hits, " << statistics.diskHits << " disk hits, "
+				  << statistics.misses << " misses\n";
+	}
+	return 0;
+}
+
+std::string minimize_to_string(unsigned char n, const logic::DNF &dnf, const logic::DNF &dontCare,
+							   const batch_options &options)
+{
+	if (options.heuristic)
+		return logic::ToLiteral(logic::MinimizeHeuristic(n, dnf, dontCare), n);
+	if (options.timeLimit >= 0)
+	{
+		logic::MinimizeOptions limits;
+		limits.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(options.timeLimit);
+		// A single thread per function, since the functions themselves are minimized in parallel
+		limits.nThreads = 1;
+		return logic::ToLiteral(logic::Minimize(n, dnf, dontCare, limits).dnf, n);
+	}
+	std::string result;
+	for (auto &mdnf : get_MDNF(n, dnf, dontCare, options.cacheDirectory, 1))
+		result += (result.empty() ? "" : " ") + logic::ToLiteral(mdnf, n);
+	return result;
+}
+
+int minimize_batch(std::istream &input, const arglist &defaults, const batch_options &options, unsigned nThreads)
+{
+	if (nThreads == 0)
+		nThreads = std::max(1U, std::thread::hardware_concurrency());
+	// Functions that have been read but not minimized yet
+	struct job
+	{
+		size_t index;
+		unsigned char n;
+		logic::DNF dnf, dontCare;
+	};
+	std::deque<job> jobs;
+	// Results that have been computed but not printed yet
+	std::map<size_t, std::string> results;
+	size_t nRead = 0, nPrinted = 0;
+	bool isInputDone = false;
+	std::mutex mutex;
+	std::condition_variable jobAdded, resultAdded;
+
+	std::vector<std::thread> workers;
+	for (unsigned i = 0; i < nThreads; ++i)
+		workers.emplace_back([&]() {
+			std::unique_lock<std::mutex> lock(mutex);
+			while (true)
+			{
+				jobAdded.wait(lock, [&]() { return !jobs.empty() || isInputDone; });
+				if (jobs.empty())
+					return;
+				job current = std::move(jobs.front());
+				jobs.pop_front();
+				lock.unlock();
+				std::string result = minimize_to_string(current.n, current.dnf, current.dontCare, options);
+				lock.lock();
+				results[current.index] = std::move(result);
+				resultAdded.notify_all();
+			}
+		});
+
+	// Prints the results that are next in the input order. Must be called with the mutex locked.
+	auto print = [&]() {
+		for (auto it = results.begin(); it != results.end() && it->first == nPrinted; it = results.erase(it), ++nPrinted)
+			std::cout << it->second << '\n';
+		std::cout.flush();
+	};
+
+	// Only a limited number of functions are held in memory, so the input may be arbitrarily long
+	size_t window = 4 * nThreads;
+	std::string line;
+	for (size_t lineNumber = 1; std::getline(input, line); ++lineNumber)
+	{
+		arglist args = defaults;
+		std::istringstream words(line);
+		for (std::string word; words >> word;)
+			args.push_back(word);
+		if (args.size() == defaults.size() || args[defaults.size()][0] == '#')
+			continue;
+		job current{nRead++, 0, {}, {}};
+		// Errors are reported along with the number of the line
+		std::ostringstream errors;
+		auto buffer = std::cerr.rdbuf(errors.rdbuf());
+		int error = extract_input_variables(args.begin(), args.end(), current.dnf, current.dontCare, current.n);
+		if (!error && options.timeLimit >= 0 && current.n > logic::TruthTable::MAX_VARIABLES)
+			std::cerr << "Time limit is supported for at most " << +logic::TruthTable::MAX_VARIABLES
+					  << " variables.\n", error = -1;
+		std::cerr.rdbuf(buffer);
+
+		std::unique_lock<std::mutex> lock(mutex);
+		if (error)
+		{
+			std::cerr << "Line " << lineNumber << ": " << errors.str();
+			results[current.index] = "";
+		}
+		else
+		{
+			jobs.push_back(std::move(current));
+			jobAdded.notify_one();
+		}
+		print();
+		resultAdded.wait(lock, [&]() {
+			print();
+			return nRead - nPrinted < window;
+		});
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		isInputDone = true;
+		jobAdded.notify_all();
+		resultAdded.wait(lock, [&]() {
+			print();
+			return nPrinted == nRead;
+		});
+	}
+	for (auto &worker : workers)
+		worker.join();
 	return 0;
 }
 
@@ -111,20 +624,24 @@ int minimize(const arglist_iter &begin, const arglist_iter &end)
 	return minimize(begin, end, nullptr);
 }
 
-int extract_input_variables(const arglist_iter &begin, const arglist_iter &end, logic::DNF &dnf, logic::DNF &dontCare, unsigned char &n)
+int extract_input_variables(const arglist_iter &begin, const arglist_iter &end, logic::DNF &dnf, logic::DNF &dontCare,
+							unsigned char &n, std::optional<logic::TruthTable> *table, logic::PLA *outputs,
+							logic::PLA *labels)
 {
-	bool minterms = false;
+	bool minterms = false, truthTable = false;
 	int n_expressions = 0;
-	std::string *expr = nullptr, *expr_dontCare = nullptr;
+	std::string *expr = nullptr, *expr_dontCare = nullptr, *pla = nullptr;
 	// Extract all arguments
 	for (auto it = begin; it != end; ++it)
 	{
 		if (*it == "--help" || *it == "-h")
 			return help(), true;
 		else if (*it == "--minterms" || *it == "-m")
-			minterms = true;
+			minterms = true, truthTable = false;
+		else if (*it == "--truth-table" || *it == "-T")
+			truthTable = true, minterms = false;
 		else if (*it == "--expression" || *it == "-e")
-			minterms = false;
+			minterms = false, truthTable = false;
 		else if (*it == "--variable-count" || *it == "-n")
 		{
 			if (it + 1 == end || !extract_n(*++it, n) || n > numeric::LONG_LONG_SIZE)
@@ -136,6 +653,12 @@ int extract_input_variables(const arglist_iter &begin, const arglist_iter &end,
 				return std::cerr << "No don't care combinations specified.\n", -1;
 			expr_dontCare = &*it;
 		}
+		else if (*it == "--pla" || *it == "-p")
+		{
+			if (++it == end)
+				return std::cerr << "No PLA file specified.\n", -1;
+			n_expressions++, pla = &*it;
+		}
 		else
 		{
 			if ((*it)[0] == '-')
@@ -151,6 +674,23 @@ int extract_input_variables(const arglist_iter &begin, const arglist_iter &end,
 	else if (n_expressions > 1)
 		return std::cerr << "Extra arguments.\n", -1;
 
+	if (pla != nullptr)
+	{
+		if (expr_dontCare != nullptr)
+			return std::cerr << "Don't care combinations of a PLA are specified in the PLA itself.\n", -1;
+		if (outputs == nullptr)
+			return read_PLA(*pla, dnf, dontCare, n, labels);
+		eval(read_PLA(*pla, *outputs))
+		n = outputs->nInputs;
+		return 0;
+	}
+
+	if (outputs != nullptr)
+		return extract_outputs(minterms, truthTable, *expr, expr_dontCare, n, *outputs);
+
+	if (truthTable)
+		return extract_truth_table(*expr, expr_dontCare, n, dnf, dontCare, table);
+
 	// Extract all required DNF objects
 	eval(extract_DNFs(minterms, expr, expr_dontCare, dnf, dontCare, n))
 
@@ -173,4 +713,76 @@ int extract_DNFs(
 	return 0;
 }
 
+int extract_outputs(bool minterms, bool truthTable, const std::string &expr, const std::string *expr_dontCare,
+					unsigned char &n, logic::PLA &outputs)
+{
+	auto split = [](const std::string &s) {
+		std::vector<std::string> parts;
+		for (size_t start = 0;;)
+		{
+			size_t separator = s.find(';', start);
+			parts.push_back(s.substr(start, separator - start));
+			if (separator == std::string::npos)
+				return parts;
+			start = separator + 1;
+		}
+	};
+	auto functions = split(expr);
+	std::vector<std::string> dontCares;
+	if (expr_dontCare != nullptr && (dontCares = split(*expr_dontCare)).size() != functions.size())
+		return std::cerr << "The number of don't care lists doesn't match the number of outputs.\n", -1;
+	if (functions.size() > logic::MAX_OUTPUTS)
+		return std::cerr << "At most " << +logic::MAX_OUTPUTS << " outputs are supported.\n", -1;
+	auto extract = [&](size_t o, unsigned char &nOutput, logic::DNF &dnf, logic::DNF &dontCare) {
+		const std::string *dontCareOutput = dontCares.empty() ? nullptr : &dontCares[o];
+		return truthTable ? extract_truth_table(functions[o], dontCareOutput, nOutput, dnf, dontCare, nullptr)
+						  : extract_DNFs(minterms, &functions[o], dontCareOutput, dnf, dontCare, nOutput);
+	};
+	// All outputs need the same number of variables, so they are all read once to find it
+	for (size_t o = 0; n == 0 && o < functions.size(); ++o)
+	{
+		unsigned char nOutput = 0;
+		logic::DNF dnf, dontCare;
+		eval(extract(o, nOutput, dnf, dontCare))
+		n = std::max(n, nOutput);
+	}
+	outputs.nInputs = n;
+	outputs.on.assign(functions.size(), {});
+	outputs.dontCare.assign(functions.size(), {});
+	for (size_t o = 0; o < functions.size(); ++o)
+	{
+		unsigned char nOutput = n;
+		eval(extract(o, nOutput, outputs.on[o], outputs.dontCare[o]))
+	}
+	return 0;
+}
+
+int extract_truth_table(const std::string &expr, const std::string *expr_dontCare, unsigned char &n,
+						logic::DNF &dnf, logic::DNF &dontCare, std::optional<logic::TruthTable> *table)
+{
+	std::vector<ullong> on, dc;
+	logic::ParseError error;
+	if (!logic::ParseBitmap(expr, n, on, error))
+		return std::cerr << "Offset " << error.offset << ": " << error.message << ".\n"
+						 << "Specified truth table is of illegal format.\n", -1;
+	if (expr_dontCare != nullptr && !logic::ParseBitmap(*expr_dontCare, n, dc, error))
+		return std::cerr << "Offset " << error.offset << ": " << error.message << ".\n"
+						 << "Illegal don't care combinations specified.\n", -1;
+	logic::TruthTable result(n);
+	for (ullong i = 0; i < result.GetWordCount(); ++i)
+	{
+		result.SetOnWord(i, on[i]);
+		if (!dc.empty())
+			result.SetDontCareWord(i, dc[i]);
+	}
+	if (table != nullptr)
+		table->emplace(std::move(result));
+	else
+	{
+		dnf = result.ToDNF();
+		dontCare = result.ToDontCareDNF();
+	}
+	return 0;
+}
+
 }
@@ -1,10 +1,19 @@
 #pragma once
 
+#include <optional>
 #include <sstream>
 
 #include "program.h"
 #include "../logic/Implicant.h"
 #include "../logic/McCluskey.h"
+#include "../logic/Espresso.h"
+#include "../logic/IncrementalMinimizer.h"
+#include "../logic/MDNFCache.h"
+#include "../logic/MDNFDatabase.h"
+#include "../logic/MDNFFamily.h"
+#include "../logic/MultiOutput.h"
+#include "../logic/PLA.h"
+#include "../logic/Parser.h"
 
 namespace minimize
 {
@@ -21,12 +30,137 @@ const char *help_options();
 
 const char *help_examples();
 
+/**
+ * @return Help for the options that are exclusive to the minimize command,
+ * as opposed to those that describe its input.
+ */
+const char *help_command_options();
+
 void help();
 
+/**
+ * @return The result cache shared by all invocations of the minimize command.
+ */
+logic::MDNFCache &get_cache();
+
+/**
+ * Finds the MDNFs of a function through the result cache if the function fits into a truth table.
+ * @param cacheDirectory - Directory of the on-disk tier of the cache, which is not used if empty.
+ * @param nThreads - Number of threads of the minimization, 0 meaning all hardware threads.
+ */
+std::set<logic::DNF> get_MDNF(unsigned char n, const logic::DNF &dnf, const logic::DNF &dontCare,
+							  const std::string &cacheDirectory, unsigned nThreads = 0);
+
+/**
+ * Finds the MDNFs of a function given by its truth table through the result cache.
+ */
+std::set<logic::DNF> get_MDNF(const logic::TruthTable &table, const std::string &cacheDirectory,
+							  unsigned nThreads = 0);
+
+/**
+ * Reads a single-output PLA from the file at <code>path</code>, or from the standard input if it is "-".
+ * Also print any error messages.
+ * @param labels - If not null, receives the input and output labels of the PLA, without its cubes.
+ * @return 0 on success
+ */
+int read_PLA(const std::string &path, logic::DNF &dnf, logic::DNF &dontCare, unsigned char &n,
+			 logic::PLA *labels = nullptr);
+
+/**
+ * Reads a PLA with any number of outputs from the file at <code>path</code>, or from the standard input if it is "-".
+ * Also print any error messages.
+ * @return 0 on success
+ */
+int read_PLA(const std::string &path, logic::PLA &pla);
+
+/**
+ * Writes <code>pla</code> to the file at <code>path</code>, or to the standard output if it is "-".
+ * @return 0 on success
+ */
+int write_PLA(const std::string &path, const logic::PLA &pla);
+
+/**
+ * Writes <code>dnf</code> as a PLA to the file at <code>path</code>, or to the standard output if it is "-".
+ * @param labels - PLA whose input and output labels are written along with the function.
+ * @return 0 on success
+ */
+int write_PLA(const std::string &path, unsigned char n, const logic::DNF &dnf, const logic::PLA &labels = {});
+
+/**
+ * @return Textual representation of <code>dnf</code> like <code>logic::ToLiteral()</code>, but with the given names
+ * of the variables if there is one for each. Names longer than a letter are separated by * within a product.
+ */
+std::string to_literal(const logic::DNF &dnf, unsigned char n, const std::vector<std::string> &labels);
+
+/**
+ * Options of the minimize command that apply to each function of a batch.
+ */
+struct batch_options
+{
+	bool heuristic;
+	long long timeLimit;
+	std::string cacheDirectory;
+};
+
+/**
+ * @return MDNFs of the function separated by spaces, or the single DNF found by the heuristic
+ * or within the time limit.
+ */
+std::string minimize_to_string(unsigned char n, const logic::DNF &dnf, const logic::DNF &dontCare,
+							   const batch_options &options);
+
+/**
+ * Minimizes each line of <code>input</code> as a separate function on <code>nThreads</code> threads.
+ * A line holds the arguments of the minimize command that describe a function, preceded by
+ * <code>defaults</code>. Empty lines and lines starting with # are skipped. Results are printed
+ * one line per function as soon as all the functions before it are done, so the output is
+ * in input order. A function that can't be read gets an empty line and an error message.
+ * @param nThreads - Number of threads, 0 meaning all hardware threads.
+ */
+int minimize_batch(std::istream &input, const arglist &defaults, const batch_options &options, unsigned nThreads);
+
+/**
+ * Function of the last minimize command that found all MDNFs of a truth table, which interactive mode
+ * keeps modifying. Its incremental minimizer is created by the first modification, so that the prime implicants
+ * of a function that is never modified are not found twice.
+ */
+struct session
+{
+	std::optional<logic::TruthTable> table;
+	std::optional<logic::IncrementalMinimizer> minimizer;
+};
+
+/**
+ * @return The function modified by the interactive commands add, remove and dont-care.
+ */
+session &get_session();
+
+/**
+ * Interactive command that adds the given minterms to the ON set of the session function and minimizes it again.
+ */
+int add_minterms(const arglist_iter &begin, const arglist_iter &end);
+
+/**
+ * Interactive command that removes the given minterms from the session function and minimizes it again.
+ */
+int remove_minterms(const arglist_iter &begin, const arglist_iter &end);
+
+/**
+ * Interactive command that makes the given minterms of the session function don't care and minimizes it again.
+ */
+int set_dont_care(const arglist_iter &begin, const arglist_iter &end);
+
+/**
+ * Writes the database of precomputed MDNFs to the path given as the only argument.
+ * This command is run by the build and is not listed in the help.
+ */
+int generate_database(const arglist_iter &begin, const arglist_iter &end);
+
 /**
  * Convert a string containing a literal mathematical expression
  * into a DNF. If n=0, automatically determine the number of
- * variables and store that number into n.
+ * variables and store that number into n. Errors are printed
+ * along with the offset at which they were found.
  * @param s - String to read from
  * @param n - Variable count
  * @param dnf - Output DNF
@@ -37,7 +171,7 @@ bool string_to_DNF(const std::string &s, unsigned char &n, logic::DNF &dnf, char
 
 /**
  * Convert a string containing a list of minterm indices into a DNF.
- * The minterm indices are separated by a comma. If n=0, automatically
+ * The minterm indices or ranges of indices (e.g. 0-15) are separated by a comma. If n=0, automatically
  * determine the number of variables and store that number into n.
  * @param s - String to read from
  * @param dnf - Output DNF
@@ -49,8 +183,15 @@ bool index_list_to_DNF(const std::string &s, logic::DNF &dnf, unsigned char &n);
 /**
  * Helper function. Parse arguments to generate the logical expression
  * to minimize, don't care combinations and variable count.
+ * @param table - If not null and the function is given as a truth table, the truth table is stored
+ * here and dnf and dontCare are left empty. Otherwise the truth table is converted into DNFs.
+ * @param outputs - If not null, the input is read as several functions (see <code>extract_outputs</code>),
+ * which are stored here, and dnf and dontCare are left empty.
+ * @param labels - If not null and a single function is read from a PLA, receives the labels of the PLA.
  */
-int extract_input_variables(const arglist_iter &begin, const arglist_iter &end, logic::DNF &dnf, logic::DNF &dontCare, unsigned char &n);
+int extract_input_variables(const arglist_iter &begin, const arglist_iter &end, logic::DNF &dnf, logic::DNF &dontCare,
+							unsigned char &n, std::optional<logic::TruthTable> *table = nullptr,
+							logic::PLA *outputs = nullptr, logic::PLA *labels = nullptr);
 
 /**
  * Helper function. Convert input strings into the DNF to be minimized and
@@ -61,4 +202,23 @@ int extract_DNFs(
 		bool minterms, const std::string *expr, const std::string *expr_dontCare,
 		logic::DNF &dnf, logic::DNF &dontCare, unsigned char &n);
 
+/**
+ * Helper function. Read several functions of the same variables, separated by semicolons, along with
+ * their don't care combinations, which must either be separated the same way or not given at all.
+ * If n=0, the variable count is the largest one needed by any function. Also print any error messages.
+ * @param outputs - Output PLA, whose input and output labels are left empty.
+ * @return 0 on success
+ */
+int extract_outputs(bool minterms, bool truthTable, const std::string &expr, const std::string *expr_dontCare,
+					unsigned char &n, logic::PLA &outputs);
+
+/**
+ * Helper function. Read the function and don't care combinations given as truth tables.
+ * Also print any error messages.
+ * @see <code>extract_input_variables</code>
+ * @return 0 on success
+ */
+int extract_truth_table(const std::string &expr, const std::string *expr_dontCare, unsigned char &n,
+						logic::DNF &dnf, logic::DNF &dontCare, std::optional<logic::TruthTable> *table);
+
 }
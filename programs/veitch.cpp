@@ -41,22 +41,22 @@ int veitch(const arglist_iter &begin, const arglist_iter &end)
 		}
 	}
 
-	std::set<logic::DNF> dnfs;
 	logic::DNF dnf, dontCare;
 	unsigned char n = 0;
 
 	eval(minimize::extract_input_variables(args_minimize.begin(), args_minimize.end(), dnf, dontCare, n))
 
-	if (minimize)
-		dnfs = logic::GetMDNF(n, dnf, dontCare);
-	else
-		dnfs.insert(dnf);
+	if (!minimize)
+	{
+		logic::VeitchDiagram(n, dnf, dontCare, false).Print(std::cout, border) << '\n';
+		return 0;
+	}
 
-	if (show_n == 0)
-		show_n = dnfs.size();
-	int i = 0;
-	for (auto it = dnfs.begin(); i < show_n && it != dnfs.end(); ++i, ++it)
-		logic::VeitchDiagram(n, *it, dontCare, false).Print(std::cout, border) << '\n';
+	// MDNFs are found one at a time, so only those that are shown are ever built
+	logic::MDNFEnumerator mdnfs(n, dnf, dontCare);
+	logic::DNF mdnf;
+	for (int i = 0; (show_n == 0 || i < show_n) && mdnfs.Next(mdnf); ++i)
+		logic::VeitchDiagram(n, mdnf, dontCare, false).Print(std::cout, border) << '\n';
 
 	return 0;
 }
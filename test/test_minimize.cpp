@@ -1,6 +1,65 @@
 #include "test_minimize.h"
+#include <filesystem>
+#include <random>
 #include <stdexcept>
 
+#include "../logic/MultiOutput.h"
+#include "../logic/IncrementalMinimizer.h"
+#include "../logic/MDNFEnumerator.h"
+#include "../logic/CoverSolver.h"
+#include "../logic/MDNFCache.h"
+#include "../logic/CoverageMatrix.h"
+
+/**
+ * @return A random function of <code>n</code> variables, given as the union of random cubes,
+ * so that it has far fewer prime implicants than a function with random minterms.
+ */
+TruthTable _RandomCubes(unsigned char n, std::mt19937_64 &generator)
+{
+	TruthTable table(n);
+	for (int i = 0; i < 4 * n; ++i)
+	{
+		ullong mask = 0;
+		for (unsigned char v = 0; v < n; ++v)
+			if (generator() % 3 != 0)
+				mask |= 1ULL << v;
+		Implicant cube(generator() & mask, mask);
+		if (i % 4 == 3)
+			table.AddDontCare(cube);
+		else
+			table.Add(cube);
+	}
+	return table;
+}
+
+/** @return The function of <code>table</code> with its inputs randomly permuted and negated. */
+TruthTable _RandomNPTransform(const TruthTable &table, std::mt19937_64 &generator)
+{
+	unsigned char n = table.GetVariableCount();
+	std::vector<unsigned char> order(n);
+	for (unsigned char i = 0; i < n; ++i)
+		order[i] = i;
+	std::shuffle(order.begin(), order.end(), generator);
+	ullong negation = generator() & full_mask(n);
+	TruthTable result(n);
+	for (ullong minterm = 0; minterm < table.GetSize(); ++minterm)
+	{
+		ullong image = 0;
+		for (unsigned char i = 0; i < n; ++i)
+			image |= ((minterm ^ negation) >> i & 1) << order[i];
+		result.SetOn(image, table.IsOn(minterm));
+		result.SetDontCare(image, table.IsDontCare(minterm));
+	}
+	return result;
+}
+
+/** @return Whether two sets are equal, as implicants can only be ordered. */
+template<class Set>
+bool _Equal(const Set &x, const Set &y)
+{
+	return !(x < y) && !(y < x);
+}
+
 void test1()
 {
 	PrintMDNF(4, {4, 5, 6, 9, 11, 13});
@@ -127,3 +186,228 @@ void testExtrapolate1()
 	DNF dnf;
 	ExtrapolateMintermsAndAdd(4, i, dnf);
 }
+
+void testTruthTable1()
+{
+	TruthTable table(8, {{"AB'", 8}, {"CDH", 8}}, {{"A'B'CDEFGH", 8}});
+	DNF dnf = table.ToDNF();
+	std::cout << dnf.size() << '\n' << ToLiteral(*GetMDNF(table).begin(), 8);
+	// Expected: 87
+	//			 AB'+CDH
+}
+
+void testMultiOutput1()
+{
+	// Random functions of 6 variables with don't cares, the last output is the same as the first
+	std::mt19937_64 generator(1);
+	int nWrong = 0;
+	for (int test = 0; test < 50; ++test)
+	{
+		std::vector<TruthTable> tables(3, TruthTable(6));
+		for (int o = 0; o < 2; ++o)
+		{
+			tables[o].SetOnWord(0, generator());
+			tables[o].SetDontCareWord(0, generator() & generator() & generator());
+		}
+		tables[2] = tables[0];
+		auto result = MinimizeMultiOutput(tables);
+		// Each DNF has to cover the ON set of its output, but nothing outside the don't care set
+		for (size_t o = 0; o < tables.size(); ++o)
+		{
+			ullong on = TruthTable(6, result.dnfs[o]).OnWord(0);
+			nWrong += (tables[o].RequiredWord(0) & ~on) != 0 || (on & ~tables[o].CareWord(0)) != 0;
+		}
+		nWrong += !_Equal(result.dnfs[2], result.dnfs[0]);
+	}
+	std::cout << nWrong;
+	// Expected: 0
+}
+
+void testIncremental1()
+{
+	// Random edits of a function of 8 variables, after each of which the prime implicants are found from scratch
+	std::mt19937_64 generator(2);
+	TruthTable table(8);
+	for (ullong i = 0; i < table.GetWordCount(); ++i)
+		table.SetOnWord(i, generator() & generator());
+	IncrementalMinimizer minimizer(table);
+	int nWrong = 0;
+	for (int edit = 0; edit < 1000; ++edit)
+	{
+		ullong minterm = generator() % table.GetSize();
+		switch (generator() % 3)
+		{
+			case 0:
+				minimizer.AddMinterm(minterm);
+				break;
+			case 1:
+				minimizer.RemoveMinterm(minterm);
+				break;
+			default:
+				minimizer.SetDontCare(minterm, generator() % 2);
+		}
+		nWrong += !_Equal(minimizer.GetPrimeImplicants(), GetPrimeImplicants(minimizer.GetTable()));
+		if (edit % 50 == 0)
+			nWrong += !_Equal(minimizer.GetMDNF(), GetMDNF(minimizer.GetTable()));
+	}
+	std::cout << nWrong;
+	// Expected: 0
+}
+
+void testEnumerator1()
+{
+	// Random functions of 6 variables with don't cares, whose forms have to be enumerated once each
+	std::mt19937_64 generator(3);
+	int nWrong = 0;
+	for (int test = 0; test < 200; ++test)
+	{
+		TruthTable table(6);
+		table.SetOnWord(0, generator());
+		table.SetDontCareWord(0, generator() & generator());
+		MDNFEnumerator enumerator(table);
+		std::set<DNF> mdnfs;
+		size_t count = 0;
+		for (DNF mdnf; enumerator.Next(mdnf); ++count)
+			mdnfs.insert(mdnf);
+		nWrong += count != mdnfs.size() || !_Equal(mdnfs, GetMDNF(table));
+	}
+	std::cout << nWrong;
+	// Expected: 0
+}
+
+void testParallelPrimeImplicants1()
+{
+	// With 8 threads, functions of 11 to 13 variables are split on 1 to 3 variables
+	std::mt19937_64 generator(4);
+	int nWrong = 0;
+	for (int test = 0; test < 30; ++test)
+	{
+		TruthTable table = _RandomCubes(11 + test % 3, generator);
+		nWrong += !_Equal(GetPrimeImplicants(table, 8), GetPrimeImplicants(table));
+	}
+	std::cout << nWrong;
+	// Expected: 0
+}
+
+void testImplicitPrimeImplicants1()
+{
+	// Functions of 6 to 16 variables, including those that GetPrimeImplicants() handles implicitly on one thread
+	std::mt19937_64 generator(5);
+	int nWrong = 0;
+	for (int test = 0; test < 33; ++test)
+	{
+		TruthTable table = _RandomCubes(6 + test % 11, generator);
+		ImplicantTable implicit;
+		GetImplicitPrimeImplicants(table, implicit);
+		nWrong += !_Equal(implicit.ToDNF(), GetPrimeImplicants(table));
+	}
+	std::cout << nWrong;
+	// Expected: 0
+}
+
+void testParallelCoverSolver1()
+{
+	// Cyclic cores of random functions of 7 variables, of which those with at least 32 columns are searched in parallel
+	std::mt19937_64 generator(6);
+	int nWrong = 0;
+	for (int nCores = 0; nCores < 15;)
+	{
+		TruthTable table(7);
+		for (ullong i = 0; i < table.GetWordCount(); ++i)
+		{
+			table.SetOnWord(i, generator());
+			table.SetDontCareWord(i, generator() & generator() & generator());
+		}
+		ImplicantTable primeImplicants;
+		GetPrimeImplicants(table, primeImplicants);
+		std::vector<ullong> minterms;
+		table.ForEachRequired([&minterms](ullong minterm) {
+			minterms.push_back(minterm);
+		});
+		CoverTable coverTable(primeImplicants, minterms);
+		coverTable.Reduce();
+		size_t nColumns = 0;
+		for (size_t column = 0; column < coverTable.GetColumnCount(); ++column)
+			nColumns += coverTable.IsColumnActive(column);
+		if (nColumns < 32)
+			continue;
+		++nCores;
+		CoverSolver serial(coverTable), parallel(coverTable);
+		nWrong += serial.Solve(1) != parallel.Solve(4);
+		nWrong += CoverSolver(coverTable).FindMinimumCost(4) != serial.GetMinimumCost();
+	}
+	std::cout << nWrong;
+	// Expected: 0
+}
+
+void testCache1()
+{
+	// Random functions of 5 to 7 variables, each followed by a random NP transform of it, which shares its file
+	std::mt19937_64 generator(7);
+	std::vector<TruthTable> tables;
+	for (int i = 0; i < 30; ++i)
+	{
+		TruthTable table(5 + i % 3);
+		ullong wordMask = table.GetSize() < 64 ? full_mask(table.GetSize()) : ~0ULL;
+		for (ullong j = 0; j < table.GetWordCount(); ++j)
+		{
+			table.SetOnWord(j, generator() & wordMask);
+			table.SetDontCareWord(j, generator() & generator() & wordMask);
+		}
+		tables.push_back(table);
+		tables.push_back(_RandomNPTransform(table, generator));
+	}
+	auto directory = (std::filesystem::temp_directory_path() / "acpp-test-cache").string();
+	std::filesystem::remove_all(directory);
+	int nWrong = 0;
+	// A memory tier of 4 entries evicts most of them, so they are read back from the disk or computed again
+	auto check = [&](MDNFCache &cache) {
+		for (int pass = 0; pass < 2; ++pass)
+			for (auto &table : tables)
+				nWrong += !_Equal(cache.GetMDNF(table, 1), ComputeMDNFSet(table, 1).ToSet());
+	};
+	MDNFCache memoryCache(4), diskCache(4, directory);
+	check(memoryCache);
+	check(diskCache);
+	// A new instance only has the files, which hold the canonical form of each pair
+	MDNFCache reloadedCache(4, directory);
+	check(reloadedCache);
+	std::filesystem::remove_all(directory);
+	// Each transform is found through the entry of the function it was derived from, so only the latter miss,
+	// in both passes without a directory, since the small memory tier has evicted them by the second one
+	std::cout << nWrong << ' ' << memoryCache.GetStatistics().misses << ' ' << diskCache.GetStatistics().misses << ' '
+			  << reloadedCache.GetStatistics().misses;
+	// Expected: 0 60 30 0
+}
+
+void testCoverageMatrix1()
+{
+	// The kernels chosen for this processor against plain word operations, on rows of 1 to 300 columns
+	std::mt19937_64 generator(8);
+	int nWrong = 0;
+	for (size_t nColumns = 1; nColumns <= 300; ++nColumns)
+	{
+		CoverageMatrix matrix(2, nColumns);
+		for (size_t column = 0; column < nColumns; ++column)
+		{
+			if (generator() % 4 != 0)
+				matrix.Set(0, column);
+			if (generator() % 4 != 0)
+				matrix.Set(1, column);
+		}
+		size_t nWords = matrix.GetWordCount();
+		std::vector<ullong> result(nWords);
+		CoverageMatrix::Or(result.data(), matrix.Row(0), matrix.Row(1), nWords);
+		bool isFull = true;
+		for (size_t i = 0; i < nWords; ++i)
+		{
+			ullong expected = matrix.Row(0)[i] | matrix.Row(1)[i];
+			nWrong += result[i] != expected;
+			ullong columns = i * 64 + 64 <= nColumns ? ~0ULL : i * 64 < nColumns ? full_mask(nColumns - i * 64) : 0;
+			isFull &= (~expected & columns) == 0;
+		}
+		nWrong += matrix.IsFull(result.data()) != isFull;
+	}
+	std::cout << nWrong;
+	// Expected: 0
+}
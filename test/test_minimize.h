@@ -29,4 +29,22 @@ void test11();
 
 void test12();
 
-void testExtrapolate1();
\ No newline at end of file
+void testExtrapolate1();
+
+void testTruthTable1();
+
+void testMultiOutput1();
+
+void testIncremental1();
+
+void testEnumerator1();
+
+void testParallelPrimeImplicants1();
+
+void testImplicitPrimeImplicants1();
+
+void testParallelCoverSolver1();
+
+void testCache1();
+
+void testCoverageMatrix1();
\ No newline at end of file
@@ -9,6 +9,11 @@ specs=(
 "acpp minimize -n 4 ABC'+ACD'+B'CD+A'BD -e"			"AB'C+ABD'+A'CD+BC'D
 								 A'BD+ABC'+ACD'+B'CD"
 "acpp minimize --minterms    -d	 0,2,3 0,1,5,10,13,14"		"A'B'+ACD'+BC'D"
+"acpp minimize --heuristic ABC+ABCD+AB'C"			"AC"
+"acpp minimize --time-limit 1000 --minterms 0,1,5,10,13,14"	"A'B'C'+ACD'+BC'D"
+"acpp minimize --truth-table 0xE8"				"AB+AC+BC"
+"acpp minimize --cnf --minterms 0,1,2,3,4,5"			"(A'+B')"
+"acpp minimize --count --minterms 1-30"				"24"
 
 )
 
@@ -77,6 +82,64 @@ test() {
 	echo -e "$(c grn)Command $n successful$(c def)\n"
 }
 
+# Commands whose output and error output must match exactly, line by line.
+# Each command is followed by its expected output and its expected error output
+exact_specs=(
+
+"acpp minimize --batch batch.txt --minterms"
+"A'+B'
+A'B+AB'
+BD
+
+A'B'+ACD'+BC'D"
+"Line 6: Offset 2: Expected a minterm index.
+Specified DNF is of illegal format."
+"acpp minimize --outputs --minterms 3,6,7;1,6,7;3,6,7"
+"The following minimal DNFs with shared product terms have been found:
+f1 = AB+BC
+f2 = A'B'C+AB
+f3 = AB+BC"
+""
+"acpp minimize --pla majority.pla"
+"The following MDNFs have been found:
+a+bc"
+""
+"acpp minimize --pla majority.pla --write-pla -"
+".i 3
+.o 1
+.ilb a b c
+.ob f
+.type f
+.p 2
+1-- 1
+-11 1
+.e"
+""
+"acpp minimize --pla short.pla"
+""
+"short.pla: Line 4: the row is too short"
+
+)
+
+# Usage: test_exact command expected_output expected_errors
+test_exact() {
+	errors_file=$(mktemp)
+	output="$($1 2>"$errors_file")"
+	errors="$(cat "$errors_file")"
+	rm -f "$errors_file"
+
+	echo -e "$(c blu)- Command $n -$(c def)\n"
+	echo -e "$output\n"
+	echo -e "Expected:\n$2\n"
+
+	if [ "$output" != "$2" ] || [ "$errors" != "$3" ]; then
+		echo -e "Errors:\n$errors\n\nExpected errors:\n$3\n"
+		echo -e "$(c red)Error in command $n$(c def)\n" >&2
+		return 1
+	fi
+	echo -e "$(c grn)Command $n successful$(c def)\n"
+}
+
 size=${#specs[*]}
 
 if (( $size % 2)); then
@@ -86,3 +149,12 @@ for i in $( seq 0 2 $(( $size - 1 )) ); do
 	n=$(($i / 2))
 	test "${specs[$i]}" "${specs[ $(($i+1)) ]}"
 done
+
+exact_size=${#exact_specs[*]}
+if (( $exact_size % 3 )); then
+	echo "Invalid command/output/errors specification"; exit 1
+fi
+for i in $( seq 0 3 $(( $exact_size - 1 )) ); do
+	n=$(( $size / 2 + $i / 3 ))
+	test_exact "${exact_specs[$i]}" "${exact_specs[ $(($i+1)) ]}" "${exact_specs[ $(($i+2)) ]}"
+done